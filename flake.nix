@@ -26,7 +26,11 @@
           # pkgs.make
 
           (pkgs.writeShellScriptBin "compile" ''         
-            g++ -o tomasulo main.cpp
+            g++ -O2 -pthread -o tomasulo main.cpp
+            g++ -O2 -o tomasulo-decode tools/decode.cpp
+            g++ -O2 -o tomasulo-gen tools/gen.cpp
+            g++ -O2 -o tomasulo-bench tools/bench.cpp
+            g++ -O2 -o tomasulo-timeline tools/timeline.cpp
           '')
 
         ];
@@ -1,717 +1,521 @@
+#include <algorithm>
 #include <iostream>
 #include <fstream>
-#include <sstream>
+#include <string>
 #include <vector>
-#include <map>
-#include <iomanip>
 
-// Constantes de configuração para as unidades funcionais e registradores
-const int ADD_UNIT_CLOCK = 4;
-const int MUL_UNIT_CLOCK = 4;
-const int SW_UNIT_CLOCK = 2;
-const int ADD_UNIT_QNT = 2;
-const int MUL_UNIT_QNT = 2;
-const int SW_UNIT_QNT = 2;
-const int REGISTER_QNT = 16;
+#include "src/scheduler.hpp"
+#include "src/simulator.hpp"
+#include "src/sweep.hpp"
+#include "src/batch.hpp"
+#include "src/multicore.hpp"
+#include "src/async_output.hpp"
+#include "src/checkpoint.hpp"
+#include "src/chrome_trace.hpp"
+#include "src/dataflow.hpp"
+#include "src/engines.hpp"
+#include "src/sampling.hpp"
+#include "src/options.hpp"
+#include "src/server.hpp"
+#include "src/smt.hpp"
+#include "src/tracefile.hpp"
 
-// Definindo a estrutura de uma instrução
-class Operation
-{
-public:
-  std::string op;   // Tipo da operação (add, sub, mul, etc.)
-  std::string dest; // Registrador de destino
-  std::string src1; // Primeiro operando
-  std::string src2; // Segundo operando
-  int execCycles;   // Ciclos restantes de execução
-  bool isIssued;    // Se a instrução foi emitida
-  bool isExecuting; // Se a instrução está em execução
-  bool isCompleted; // Se a instrução foi concluída
-
-  Operation(std::string op, std::string dest, std::string src1, std::string src2)
-      : op(op), dest(dest), src1(src1), src2(src2), execCycles(0), isIssued(false), isExecuting(false), isCompleted(false) {}
-};
-
-// Definindo a estrutura de uma unidade funcional
-class FunctionalUnit
-{
-public:
-  std::string type;       // Tipo da unidade funcional (ex: add, mul)
-  int latency;            // Ciclos de latência da unidade funcional
-  bool busy;              // Indica se está ocupada
-  Operation *instruction; // Instrução atualmente em execução
-
-  FunctionalUnit(std::string type, int latency)
-      : type(type), latency(latency), busy(false), instruction(nullptr) {}
-};
-
-// Definindo a estrutura de um registrador
-class Register
-{
-public:
-  std::string name;       // Nome do registrador
-  int value;              // Valor atual do registrador
-  bool busyRead;          // Indica se o registrador está sendo lido
-  bool busyWrite;         // Indica se o registrador está sendo escrito
-  Operation *instruction; // Instrução que está utilizando o registrador
-
-  Register(std::string name, int value)
-      : name(name), value(value), busyRead(false), busyWrite(false), instruction(nullptr) {}
-};
-
-// Implementação do algoritmo de Tomasulo
-class Scheduler
+// Exemplo de uso
+int main(int argc, char *argv[])
 {
-public:
-  std::vector<Operation *> instructions;     // Lista de instruções
-  std::vector<FunctionalUnit *> addUnits;    // Unidades funcionais de soma
-  std::vector<FunctionalUnit *> mulUnits;    // Unidades funcionais de multiplicação
-  std::vector<FunctionalUnit *> swUnits;     // Unidades funcionais de store/load
-  std::vector<Register *> registers;         // Lista de registradores
-  std::map<std::string, std::string> rename; // Mapeamento para renomeação de registradores
-  int cycle;                                 // Ciclo atual
-  std::vector<int> cacheMem;                 // Cache de memória simulada
-  std::ofstream &outputFile;                 // Referência para o arquivo de saída
-
-  Scheduler(std::vector<Operation *> instructions, std::ofstream &outputFile)
-      : instructions(instructions), outputFile(outputFile), cycle(1), cacheMem(32, 2)
+  // Opções começam com "--" e podem aparecer antes dos arquivos
+  CommandLineOptions options;
+  for (int i = 1; i < argc; i++)
   {
-    addUnits = createFunctionalUnits(ADD_UNIT_QNT, "add", ADD_UNIT_CLOCK);
-    mulUnits = createFunctionalUnits(MUL_UNIT_QNT, "mul", MUL_UNIT_CLOCK);
-    swUnits = createFunctionalUnits(SW_UNIT_QNT, "sw", SW_UNIT_CLOCK);
-    registers = createRegisters(REGISTER_QNT);
+    std::string error;
+    if (!parseCommandLineOption(argv[i], options, error))
+    {
+      std::cerr << error << std::endl;
+      return 1;
+    }
   }
 
-  // Destrutor para liberar a memória alocada para as instruções
-  ~Scheduler()
+  // Servidor: os pedidos trazem o arquivo de instruções e as opções de cada simulação
+  if (options.server)
   {
-    for (const auto &instruction : instructions)
+    auto serverOption = [](const std::string &option)
     {
-      delete instruction;
-    }
-    for (const auto &unit : addUnits)
+      return option.rfind("--servidor", 0) == 0 || option.rfind("--config=", 0) == 0 ||
+             option.rfind("--threads=", 0) == 0 || option.rfind("--saidas=", 0) == 0;
+    };
+    if (!std::all_of(argv + 1, argv + argc, serverOption))
     {
-      delete unit;
+      std::cerr << "--servidor aceita apenas --config, --threads e --saidas" << std::endl;
+      return 1;
     }
-    for (const auto &unit : mulUnits)
+    std::string error;
+    if (!validateConfig(options.config, error))
     {
-      delete unit;
+      std::cerr << "Configuração inválida: " << error << std::endl;
+      return 1;
     }
-    for (const auto &unit : swUnits)
+    if (!runServer(options.socketPath, options.config, options.serverOutputDir, options.threads, error))
     {
-      delete unit;
-    }
-    for (const auto &reg : registers)
-    {
-      delete reg;
+      std::cerr << "Erro: " << error << std::endl;
+      return 1;
     }
+    return 0;
   }
-
-  // Cria as unidades funcionais
-  std::vector<FunctionalUnit *> createFunctionalUnits(int numUnits, std::string type, int latency)
+  if (!options.serverOutputDir.empty())
   {
-    std::vector<FunctionalUnit *> units;
-    for (int i = 0; i < numUnits; i++)
-    {
-      units.push_back(new FunctionalUnit(type, latency));
-    }
-    return units;
+    std::cerr << "--saidas vale apenas para --servidor" << std::endl;
+    return 1;
   }
 
-  // Cria os registradores
-  std::vector<Register *> createRegisters(int quant)
+  if (options.files.size() < 2)
   {
-    std::vector<Register *> reg;
-    for (int i = 0; i < quant; i++)
-    {
-      reg.push_back(new Register("F" + std::to_string(i), 1));
-    }
-    for (int i = 0; i < quant; i++)
-    {
-      reg.push_back(new Register("R" + std::to_string(i), 1));
-    }
-    return reg;
+    std::cerr << "Uso: " << argv[0] << " [--eventos] [--formato=delta|texto|chrome|nenhum] [--estatisticas[=resumo|json]] [--config=NOME=valor]... [--salvar=CICLO:arquivo]... [--ate=CICLO] [--restaurar=arquivo] [--comprimir] <arquivo_de_instrucoes> <arquivo_de_saida>" << std::endl;
+    std::cerr << "     " << argv[0] << " --lote [--eventos] [--formato=delta|texto] [--config=NOME=valor]... [--threads=N] <diretorio_ou_lista> <diretorio_de_saida>" << std::endl;
+    std::cerr << "     " << argv[0] << " --nucleos [--eventos] [--formato=delta|texto|nenhum] [--estatisticas[=resumo|json]] [--config=NOME=valor]... [--threads=N] [--quantum=CICLOS] <diretorio_ou_lista> <diretorio_de_saida>" << std::endl;
+    std::cerr << "     " << argv[0] << " --smt [--politica=rodizio|icount] [--formato=delta|texto|nenhum] [--estatisticas[=resumo|json]] [--config=NOME=valor]... <diretorio_ou_lista> <diretorio_de_saida>" << std::endl;
+    std::cerr << "     " << argv[0] << " --funcional | --amostragem=PERIODO:TAMANHO[:AQUECIMENTO] | --amostras=INICIO[,INICIO...]:TAMANHO[:AQUECIMENTO] [--formato=texto|json] [--config=NOME=valor]... <arquivo_de_instrucoes> <arquivo_de_saida>" << std::endl;
+    std::cerr << "     " << argv[0] << " --motor=placar|em-ordem [--formato=texto|nenhum] [--estatisticas[=resumo|json]] [--config=NOME=valor]... [--ate=CICLO] <arquivo_de_instrucoes> <arquivo_de_saida>" << std::endl;
+    std::cerr << "     " << argv[0] << " --comparar [--formato=texto|json] [--config=NOME=valor]... [--threads=N] <arquivo_de_instrucoes> <arquivo_de_saida>" << std::endl;
+    std::cerr << "     " << argv[0] << " --servidor[=SOCKET] [--config=NOME=valor]... [--threads=N] [--saidas=DIRETORIO]" << std::endl;
+    std::cerr << "     " << argv[0] << " --fluxo-de-dados[=simular] [--eventos] [--formato=texto|json] [--config=NOME=valor]... <arquivo_de_instrucoes> <arquivo_de_saida>" << std::endl;
+    std::cerr << "     " << argv[0] << " --varrer=NOME=inicio:fim[:passo]... [--config=NOME=valor]... [--threads=N] [--formato=csv|json] <arquivo_de_instrucoes> <arquivo_de_saida>" << std::endl;
+    std::cerr << "     " << argv[0] << " --pre-decodificar [--config=REGISTER_QNT=valor] <arquivo_de_instrucoes> <arquivo.ttrace>" << std::endl;
+    return 1;
   }
 
-  // Executa o algoritmo de Tomasulo
-  void run()
+  if ((options.batch || options.multicore || options.smt || !options.ranges.empty() || options.functionalOnly ||
+       !options.samplingSpec.empty()) &&
+      (!options.saves.empty() || !options.restorePath.empty() || options.stopGiven))
   {
-    while (!isExecutionComplete()) // Continua até que todas as instruções sejam concluídas
-    {
-      issue();     // Estágio de emissão
-      execute();   // Estágio de execução
-      write();     // Estágio de escrita
-      showState(); // Exibe o estado atual para debugging
-      cycle++;     // Incrementa o ciclo
-    }
-    outputFile << "\nExecução completa\n"; // Log de execução completa
+    std::cerr << "--salvar, --ate e --restaurar valem apenas para uma simulação detalhada" << std::endl;
+    return 1;
   }
-
-  void showState()
+  if (options.quantum != 1 && !options.multicore)
+  {
+    std::cerr << "--quantum vale apenas para --nucleos" << std::endl;
+    return 1;
+  }
+  if (options.multicore && (options.batch || options.smt || !options.ranges.empty() || options.functionalOnly ||
+                            !options.samplingSpec.empty() || options.preDecode))
+  {
+    std::cerr << "--nucleos não pode ser combinada com outros modos" << std::endl;
+    return 1;
+  }
+  if (options.smt && (options.batch || !options.ranges.empty() || options.functionalOnly || !options.samplingSpec.empty() ||
+                      options.preDecode || options.eventDriven))
+  {
+    std::cerr << "--smt não pode ser combinada com outros modos nem com --eventos" << std::endl;
+    return 1;
+  }
+  bool otherModes = options.batch || options.multicore || options.smt || !options.ranges.empty() ||
+                    options.functionalOnly || !options.samplingSpec.empty() || options.preDecode || options.dataflow;
+  if ((options.engine != EngineKind::Tomasulo || options.compare) &&
+      (otherModes || options.eventDriven || options.compress || !options.saves.empty() || !options.restorePath.empty()))
+  {
+    std::cerr << "--motor e --comparar não podem ser combinadas com outros modos, --eventos, --comprimir ou checkpoints"
+              << std::endl;
+    return 1;
+  }
+  if (options.compare && (options.engineGiven || options.stopGiven))
+  {
+    std::cerr << "--comparar simula todos os motores e não aceita --motor nem --ate" << std::endl;
+    return 1;
+  }
+  if (options.policyGiven && !options.smt)
+  {
+    std::cerr << "--politica vale apenas para --smt" << std::endl;
+    return 1;
+  }
+  if (options.compress && (options.batch || options.multicore || options.smt || !options.ranges.empty() ||
+                           options.functionalOnly || !options.samplingSpec.empty() || options.preDecode || options.dataflow))
+  {
+    std::cerr << "--comprimir vale apenas para uma simulação detalhada" << std::endl;
+    return 1;
+  }
+  if (options.dataflow && (options.batch || options.multicore || options.smt || !options.ranges.empty() ||
+                           options.functionalOnly || !options.samplingSpec.empty() || options.preDecode ||
+                           !options.saves.empty() || !options.restorePath.empty() || options.stopGiven))
+  {
+    std::cerr << "--fluxo-de-dados não pode ser combinada com outros modos" << std::endl;
+    return 1;
+  }
+  if ((options.functionalOnly || !options.samplingSpec.empty()) &&
+      (options.batch || !options.ranges.empty() || (options.functionalOnly && !options.samplingSpec.empty())))
+  {
+    std::cerr << "--funcional e --amostragem não podem ser combinadas com --lote, --varrer ou entre si" << std::endl;
+    return 1;
+  }
+  if (options.preDecode && (options.batch || !options.ranges.empty() || options.functionalOnly || !options.samplingSpec.empty() ||
+                            !options.saves.empty() || !options.restorePath.empty() || options.stopGiven ||
+                            !options.formatName.empty()))
+  {
+    std::cerr << "--pre-decodificar não pode ser combinada com outros modos ou formatos" << std::endl;
+    return 1;
+  }
+  SamplingPlan samplingPlan;
+  std::string samplingError;
+  if (!options.samplingSpec.empty() &&
+      !parseSamplingPlan(options.samplingSpec, options.explicitSamples, samplingPlan, samplingError))
   {
-    // Start of clock cycle state log
-    outputFile << "\n------------\nCiclo " << cycle;
+    std::cerr << "Erro: " << samplingError << std::endl;
+    return 1;
+  }
 
-    // Log issued instructions
-    outputFile << "\n> Lidas: ";
-    for (size_t i = 0; i < instructions.size(); i++)
+  // Exploração do espaço de projeto: uma linha de resultado por combinação de parâmetros
+  if (!options.ranges.empty())
+  {
+    SweepFormat sweepFormat = SweepFormat::Csv;
+    if (options.formatName == "json")
     {
-      if (instructions[i]->isIssued)
-      {
-        outputFile << "\n " << instructions[i]->op << " " << instructions[i]->dest
-                   << " " << instructions[i]->src1 << " " << instructions[i]->src2;
-      }
+      sweepFormat = SweepFormat::Json;
     }
-
-    // Log executing instructions
-    outputFile << "\n> Em execução:";
-    for (size_t i = 0; i < instructions.size(); i++)
+    else if (!options.formatName.empty() && options.formatName != "csv")
     {
-      if (instructions[i]->isExecuting)
-      {
-        outputFile << "\n " << instructions[i]->op << " " << instructions[i]->dest
-                   << " " << instructions[i]->src1 << " " << instructions[i]->src2;
-      }
+      std::cerr << "Formato inválido para a varredura: " << options.formatName << std::endl;
+      return 1;
     }
 
-    // Log completed instructions
-    outputFile << "\n> Concluídas:";
-    for (size_t i = 0; i < instructions.size(); i++)
+    std::ofstream outputFile(options.files[1], std::ios::binary);
+    if (!outputFile.is_open())
     {
-      if (instructions[i]->isCompleted)
-      {
-        outputFile << "\n " << instructions[i]->op << " " << instructions[i]->dest
-                   << " " << instructions[i]->src1 << " " << instructions[i]->src2;
-      }
+      std::cerr << "Erro ao abrir o arquivo de saída." << std::endl;
+      return 1;
     }
 
-    // detectDependencies(outputFile);
-
-    // Integrated register status logging
-    outputFile << "\n\n> Status dos Registradores:";
-    outputFile << "\n"
-               << std::left
-               << std::setw(12) << "Registrador"
-               << std::setw(10) << "Valor"
-               << std::setw(15) << "(Leitura)"
-               << std::setw(15) << "(Escrita)"
-               << "Instrução Associada\n";
-    outputFile << std::string(70, '-') << "\n";
-
-    // Iterate through registers and log their states
-    for (const auto &reg : registers)
+    std::string error;
+    if (!runSweep(options.files[0], options.config, options.ranges, options.threads, outputFile, sweepFormat, error))
     {
-      // Determine read and write status
-      std::string readStatus = reg->busyRead ? "Ocupado" : "Livre";
-      std::string writeStatus = reg->busyWrite ? "Ocupado" : "Livre";
+      std::cerr << "Erro: " << error << std::endl;
+      return 1;
+    }
+    return 0;
+  }
 
-      // Prepare instruction information
-      std::string instrInfo = "Nenhuma";
-      if (reg->instruction)
-      {
-        instrInfo = reg->instruction->op + " " +
-                    reg->instruction->dest + " " +
-                    reg->instruction->src1 + " " +
-                    reg->instruction->src2;
-      }
+  // A execução funcional grava o estado final e a amostragem o CPI estimado, em texto ou JSON
+  bool functionalMode = options.functionalOnly || !options.samplingSpec.empty();
+  if (functionalMode && !options.formatName.empty() && options.formatName != "texto" &&
+      (options.formatName != "json" || options.functionalOnly))
+  {
+    std::cerr << "Formato inválido para a execução funcional: " << options.formatName << std::endl;
+    return 1;
+  }
 
-      // Write register state to file
-      outputFile << std::left
-                 << std::setw(12) << reg->name
-                 << std::setw(10) << reg->value
-                 << std::setw(15) << readStatus
-                 << std::setw(15) << writeStatus
-                 << instrInfo << "\n";
-    }
+  if (options.dataflow && !options.formatName.empty() && options.formatName != "texto" && options.formatName != "json")
+  {
+    std::cerr << "Formato inválido para a análise de fluxo de dados: " << options.formatName << std::endl;
+    return 1;
+  }
+
+  if (options.compare && !options.formatName.empty() && options.formatName != "texto" && options.formatName != "json")
+  {
+    std::cerr << "Formato inválido para a comparação de motores: " << options.formatName << std::endl;
+    return 1;
+  }
+  if (options.engine != EngineKind::Tomasulo && !options.formatName.empty() && options.formatName != "texto" &&
+      options.formatName != "nenhum")
+  {
+    std::cerr << "O motor " << ENGINE_NAMES[static_cast<int>(options.engine)]
+              << " grava apenas --formato=texto ou nenhum" << std::endl;
+    return 1;
+  }
 
-    // Additional separator for readability
-    outputFile << std::string(70, '-') << "\n\n";
+  // A linha do tempo do Chrome é gravada pelo observador; o simulador não grava o estado por ciclo
+  bool chromeTrace = options.formatName == "chrome";
+  if (chromeTrace && (options.batch || options.multicore || options.smt))
+  {
+    std::cerr << "--formato=chrome vale apenas para uma simulação detalhada" << std::endl;
+    return 1;
+  }
+  OutputFormat format = OutputFormat::Delta;
+  if (functionalMode || options.dataflow || options.compare || options.formatName == "texto" ||
+      (options.engine != EngineKind::Tomasulo && options.formatName.empty()))
+  {
+    format = OutputFormat::Text;
+  }
+  else if (options.formatName == "nenhum" || chromeTrace)
+  {
+    format = OutputFormat::None;
+  }
+  else if (!options.formatName.empty() && options.formatName != "delta")
+  {
+    std::cerr << "Formato inválido: " << options.formatName << std::endl;
+    return 1;
   }
 
-  // Verifica se a execução está completa
-  bool isExecutionComplete()
+  // A configuração de uma simulação restaurada é a gravada no checkpoint
+  Checkpoint checkpoint;
+  std::string configError;
+  if (!options.restorePath.empty())
   {
-    for (size_t i = 0; i < instructions.size(); i++)
+    if (options.configGiven)
     {
-      if (!instructions[i]->isCompleted)
-      {
-        return false;
-      }
+      std::cerr << "--config não pode ser usado com --restaurar" << std::endl;
+      return 1;
+    }
+    if (!checkpoint.open(options.restorePath, configError) || !checkpoint.readConfig(options.config, configError))
+    {
+      std::cerr << "Erro: " << configError << std::endl;
+      return 1;
     }
-    return true;
+  }
+  if (!validateConfig(options.config, configError))
+  {
+    std::cerr << "Configuração inválida: " << configError << std::endl;
+    return 1;
   }
 
-  /**
-   * @brief Renomeia um registrador para um registrador temporário, se disponível.
-   *
-   * Esta função renomeia um registrador dado para um registrador temporário, se um estiver disponível.
-   * Primeiro, encontra um registrador temporário disponível verificando os flags busyRead e busyWrite.
-   * Se um registrador temporário disponível for encontrado, atualiza o mapa de renomeação e
-   * renomeia todas as ocorrências subsequentes do registrador alvo na lista de instruções.
-   *
-   * @param target Ponteiro para o registrador a ser renomeado.
-   * @param index O índice da instrução a partir do qual começar a renomeação.
-   *
-   * O primeiro loop itera através dos registradores temporários para encontrar um disponível.
-   * O segundo loop itera através das instruções a partir do índice dado para renomear todas as ocorrências do registrador alvo.
-   */
-  void renameRegister(Register *target, size_t index)
-  {
-    // Declara o início dos registradores temporários
-    size_t posTempReg = registers.size() / 2;
-    std::string newName = "R0";
-
-    // Loop para encontrar registrador temporário disponível
-    while (registers[posTempReg]->busyRead || registers[posTempReg]->busyWrite)
+  // Grava as instruções decodificadas em um .ttrace, que pode substituir o arquivo em texto
+  if (options.preDecode)
+  {
+    std::string error;
+    std::error_code ec;
+    if (std::filesystem::equivalent(options.files[0], options.files[1], ec))
     {
-      posTempReg++;
-      if (posTempReg >= registers.size())
-      {
-        return;
-      }
-      else
-      {
-        newName = registers[posTempReg]->name;
-      }
+      std::cerr << "Erro: o arquivo .ttrace não pode substituir o arquivo de instruções" << std::endl;
+      return 1;
     }
+    std::unique_ptr<TraceSource> trace = openTrace(options.files[0], options.config.registerQnt, error);
+    if (!trace || !writeTTrace(*trace, options.config.registerQnt, options.files[1], error))
+    {
+      std::cerr << "Erro: " << error << std::endl;
+      return 1;
+    }
+    return 0;
+  }
 
-    if (rename.find(target->name) != rename.end())
+  // Modo em lote: um arquivo de saída por arquivo de instruções, simulados em paralelo; no modo
+  // multinúcleo cada arquivo de instruções é um núcleo e todos compartilham a memória, e no modo
+  // SMT cada arquivo é uma thread de um único núcleo
+  if (options.batch || options.multicore || options.smt)
+  {
+    std::vector<std::string> inputs;
+    std::string error;
+    std::error_code ec;
+    std::filesystem::create_directories(options.files[1], ec);
+    if (ec)
     {
-      rename[newName] = rename[target->name];
+      std::cerr << "Erro ao criar o diretório de saída: " << ec.message() << std::endl;
+      return 1;
     }
-    else
+    if (!listBatchInputs(options.files[0], inputs, error))
     {
-      rename[newName] = target->name;
+      std::cerr << "Erro: " << error << std::endl;
+      return 1;
     }
-
-    // Renomear próximas ocorrências do registrador alvo
-    for (size_t i = index; i < instructions.size(); i++)
+    std::vector<BatchJob> jobs = planBatch(inputs, options.files[1], format);
+    if (options.smt)
     {
-      if (instructions[i]->dest == target->name)
-      {
-        instructions[i]->dest = newName;
-      }
-
-      if (instructions[i]->src1 == target->name)
-      {
-        instructions[i]->src1 = newName;
-      }
-
-      if (instructions[i]->src2 == target->name)
-      {
-        instructions[i]->src2 = newName;
-      }
+      return runSmt(jobs, format, options.config, options.fetchPolicy, options.statsFormat, std::cout) == 0 ? 0 : 1;
     }
-  }
-
-  // Faz o estágio de emissão (issue)
-  /**
-   * @brief Emite instruções para unidades funcionais disponíveis.
-   *
-   * A função issue() percorre a lista de instruções e tenta emitir cada instrução para uma unidade funcional disponível,
-   * dependendo do tipo de operação (add, sub, mul, div, sw, lw). Se a unidade funcional estiver disponível e os operandos
-   * necessários não estiverem ocupados, a instrução é marcada como em execução e a unidade funcional é marcada como ocupada.
-   *
-   * - Se a instrução já estiver sendo executada, completada ou não estiver emitida, ela é marcada como emitida.
-   * - Dependendo do tipo de operação, a função busca uma unidade funcional disponível correspondente.
-   * - Verifica se os operandos estão disponíveis e se há dependências falsas ou verdadeiras.
-   * - Atualiza o estado dos registradores e das unidades funcionais conforme necessário.
-   */
-  void issue()
-  {
-    size_t constrain = instructions.size();
-    if (cycle < instructions.size())
-    {
-      constrain = cycle;
-    }
-    for (size_t i = 0; i < constrain; i++)
-    {
-      Operation *instruction = instructions[i];
-      FunctionalUnit *unit = nullptr;
-      if (instruction->isExecuting || instruction->isCompleted || !instruction->isIssued)
-      {
-        instruction->isIssued = true;
-        unit = nullptr;
-      }
-      else if (instruction->op == "add" || instruction->op == "sub")
-      {
-        unit = findAvailableUnit(addUnits);
-      }
-      else if (instruction->op == "mul" || instruction->op == "div")
-      {
-        unit = findAvailableUnit(mulUnits);
-      }
-      else if (instruction->op == "sw" || instruction->op == "lw")
-      {
-        unit = findAvailableUnit(swUnits);
-      }
-
-      if (unit)
-      {
-        // Ajusta para caso de SW e LW
-        Register *aux;
-        if (instruction->op == "sw" || instruction->op == "lw")
-        {
-          aux = new Register("aux", std::stoi(instruction->src1));
-        }
-        else
-        {
-          aux = getRegister(instruction->src1);
-        }
-
-        // Verifica se os operandos estão disponíveis
-        Register *destRegister = getRegister(instruction->dest);
-        Register *src1Register = aux;
-        Register *src2Register = getRegister(instruction->src2);
-
-        // Dependência falsa
-        if (destRegister->busyRead || destRegister->busyWrite)
-        {
-          renameRegister(destRegister, i);
-        }
-
-        // Dependência verdadeira
-        if (!src1Register->busyWrite && !src2Register->busyWrite)
-        {
-          // Define a instrução como executando
-          instruction->isExecuting = true;
-          instruction->execCycles = unit->latency;
-
-          // Define a unidade funcional como ocupada
-          unit->busy = true;
-          unit->instruction = instruction;
-
-          // Atualiza os registradores utilizados pela instrução
-          destRegister->busyWrite = true;
-          destRegister->instruction = instruction;
-
-          src1Register->busyRead = true;
-          src1Register->instruction = instruction;
-
-          src2Register->busyRead = true;
-          src2Register->instruction = instruction;
-        }
-      }
+    if (options.multicore)
+    {
+      return runMulticore(jobs, format, options.eventDriven, options.config, options.threads, options.quantum,
+                          options.statsFormat, std::cout) == 0
+                 ? 0
+                 : 1;
     }
+    return runBatch(jobs, format, options.eventDriven, options.config, options.threads, std::cout) == 0 ? 0 : 1;
   }
 
-  // Faz o estágio de execução
-  /**
-   * @brief Executa o ciclo de execução das unidades funcionais.
-   *
-   * Esta função percorre todas as unidades funcionais de adição, multiplicação e armazenamento,
-   * decrementando o número de ciclos de execução restantes para cada instrução em execução.
-   * Quando o número de ciclos de execução de uma instrução chega a zero, a instrução é marcada
-   * como não mais em execução.
-   */
-  void execute()
-  {
-    for (size_t i = 0; i < addUnits.size(); i++)
-    {
-      FunctionalUnit *unit = addUnits[i];
-      if (unit->busy)
-      {
-        unit->instruction->execCycles--;
-        if (unit->instruction->execCycles == 0)
-        {
-          unit->instruction->isExecuting = false;
-        }
-      }
-    }
-
-    for (size_t i = 0; i < mulUnits.size(); i++)
+  // Todos os motores simulam o mesmo programa; o ganho de cada um é medido sobre o pipeline em ordem
+  if (options.compare)
+  {
+    std::ofstream outputFile(options.files[1], std::ios::binary);
+    if (!outputFile.is_open())
     {
-      FunctionalUnit *unit = mulUnits[i];
-      if (unit->busy)
-      {
-        unit->instruction->execCycles--;
-        if (unit->instruction->execCycles == 0)
-        {
-          unit->instruction->isExecuting = false;
-        }
-      }
+      std::cerr << "Erro ao abrir o arquivo de saída." << std::endl;
+      return 1;
     }
-
-    for (size_t i = 0; i < swUnits.size(); i++)
+    std::vector<EngineResult> results;
+    std::string error;
+    if (!compareEngines(options.files[0], options.config, options.threads, results, error))
     {
-      FunctionalUnit *unit = swUnits[i];
-      if (unit->busy)
-      {
-        unit->instruction->execCycles--;
-        if (unit->instruction->execCycles == 0)
-        {
-          unit->instruction->isExecuting = false;
-        }
-      }
+      std::cerr << "Erro: " << error << std::endl;
+      return 1;
     }
+    writeEngineComparison(outputFile, results, options.formatName == "json");
+    return 0;
   }
 
-  // Faz o estágio de escrita
-  void write()
+  // As instruções são decodificadas sob demanda, conforme a janela esvazia; um .ttrace já está decodificado
+  std::string traceError;
+  std::unique_ptr<TraceSource> traceSource = openTrace(options.files[0], options.config.registerQnt, traceError);
+  if (!traceSource)
   {
-    writeExecution(addUnits);
-    writeExecution(mulUnits);
-    writeExecution(swUnits);
+    std::cerr << "Erro: " << traceError << std::endl;
+    return 1;
   }
+  TraceSource &trace = *traceSource;
 
-  // Executa as funções da escrita
-  /**
-   * @brief Função responsável por escrever o resultado da execução das instruções nas unidades funcionais.
-   *
-   * @param unitType Vetor de ponteiros para unidades funcionais.
-   *
-   * Esta função percorre todas as unidades funcionais fornecidas e, para cada unidade que está ocupada,
-   * mas cuja instrução não está em execução e não foi completada, marca a instrução como completada e
-   * libera a unidade funcional. Dependendo da operação da instrução, atualiza o valor do registrador de
-   * destino ou a memória cache. Libera os registradores utilizados pela instrução e, se necessário,
-   * retorna o registrador renomeado.
-   */
-  void writeExecution(std::vector<FunctionalUnit *> &unitType)
-  {
-    for (size_t i = 0; i < unitType.size(); i++)
-    {
-      FunctionalUnit *unit = unitType[i];
-      if (unit->busy && !unit->instruction->isExecuting && !unit->instruction->isCompleted)
-      {
-        unit->instruction->isCompleted = true;
-        unit->busy = false;
-
-        // Atualiza o valor do registrador de destino
-        Register *destRegister = getRegister(unit->instruction->dest);
-        Register *src1Register = getRegister(unit->instruction->src1);
-        Register *src2Register = getRegister(unit->instruction->src2);
-
-        if (unit->instruction->op == "sw" || unit->instruction->op == "lw")
-        {
-          int offset = performOperation("add", std::stoi(unit->instruction->src1), src2Register->value);
-
-          if (unit->instruction->op == "sw")
-          {
-            cacheMem[offset % cacheMem.size()] = destRegister->value;
-          }
-          else if (unit->instruction->op == "lw")
-          {
-            destRegister->value = cacheMem[offset % cacheMem.size()];
-          }
-        }
-        else
-        {
-          destRegister->value = performOperation(unit->instruction->op, src1Register->value, src2Register->value);
-
-          src1Register->busyRead = false;
-          src1Register->instruction = nullptr;
-        }
-
-        // Libera os registradores utilizados pela instrução
-        destRegister->busyWrite = false;
-        destRegister->instruction = nullptr;
-
-        if (rename.find(destRegister->name) != rename.end())
-        {
-          returnRenamed(destRegister, i);
-        }
-
-        src2Register->busyRead = false;
-        src2Register->instruction = nullptr;
-      }
-    }
+  std::ofstream outputFile(options.files[1], std::ios::binary);
+  if (!outputFile.is_open())
+  {
+    std::cerr << "Erro ao abrir o arquivo de saída." << std::endl;
+    return 1;
   }
 
-  /**
-   * @brief Renomeia os registradores de destino e origem nas instruções e remove o registrador renomeado da lista de renomeados.
-   *
-   * Esta função percorre a lista de instruções e substitui os nomes dos registradores de destino e origem pelo nome renomeado.
-   * Em seguida, remove o registrador renomeado da lista de renomeados.
-   *
-   * @param target Ponteiro para o registrador que será renomeado.
-   * @param index Índice do registrador na lista de renomeados.
-   */
-  void returnRenamed(Register *target, size_t index)
-  {
-    // Renomear os valores na lista de instrução
-    for (size_t i = 0; i < instructions.size(); i++)
-    {
-      if (instructions[i]->dest == target->name)
-      {
-        instructions[i]->dest = rename[target->name];
-      }
-
-      if (instructions[i]->src1 == target->name)
-      {
-        instructions[i]->src1 = rename[target->name];
-      }
-
-      if (instructions[i]->src2 == target->name)
+  // Análise de fluxo de dados; com =simular as instruções são analisadas enquanto a simulação as lê
+  if (options.dataflow)
+  {
+    DataflowResult result;
+    if (options.dataflowSimulate)
+    {
+      DataflowAnalyzer analyzer(options.config);
+      DataflowTrace analyzed(trace, analyzer);
+      std::ostream discard(nullptr);
+      std::unique_ptr<Simulator> simulator =
+          makeSimulator(analyzed, discard, OutputFormat::None, options.eventDriven, options.config);
+      simulator->runUntil(options.stopCycle);
+      simulator->finish();
+      result = analyzer.finish();
+      result.simulatedCycles = simulator->totalCycles();
+      if (trace.error.empty())
       {
-        instructions[i]->src2 = rename[target->name];
+        trace.error = analyzed.error;
       }
     }
-
-    // Remove da lista de renomeados
-    rename.erase(target->name);
-  }
-
-  // Encontra uma unidade funcional disponível
-  FunctionalUnit *findAvailableUnit(std::vector<FunctionalUnit *> &units)
-  {
-    for (size_t i = 0; i < units.size(); i++)
+    else
     {
-      if (!units[i]->busy)
-      {
-        return units[i];
-      }
+      result = analyzeDataflow(trace, options.config);
     }
-    return nullptr;
-  }
-
-  // Obtém o registrador pelo nome
-  Register *getRegister(const std::string &name)
-  {
-    for (size_t i = 0; i < registers.size(); i++)
+    if (!trace.error.empty())
     {
-      if (registers[i]->name == name)
-      {
-        return registers[i];
-      }
+      std::cerr << "Erro na " << trace.error << std::endl;
+      return 1;
     }
-    return nullptr;
+    writeDataflowReport(outputFile, result, options.formatName == "json");
+    return 0;
   }
 
-  // Executa a operação matemática
-  int performOperation(const std::string &op, int src1, int src2)
+  // Execução funcional: apenas o estado final, sem modelo de tempo
+  if (functionalMode)
   {
-    if (op == "add")
+    FunctionalSimulator functional(options.config);
+    SamplingResult sampled;
+    if (options.functionalOnly)
+    {
+      functional.run(trace, UINT64_MAX);
+    }
+    else
     {
-      return src1 + src2;
+      sampled = runSampled(trace, options.config, samplingPlan);
     }
-    else if (op == "sub")
+    if (!trace.error.empty())
     {
-      return src1 - src2;
+      std::cerr << "Erro na " << trace.error << std::endl;
+      return 1;
     }
-    else if (op == "mul")
+    if (options.functionalOnly)
     {
-      return src1 * src2;
+      functional.writeState(outputFile);
     }
-    else if (op == "div")
+    else
     {
-      return src1 / src2;
+      writeSamplingReport(outputFile, sampled, options.formatName == "json");
     }
     return 0;
   }
-  //  deu mais ou menos certo, ainda tem bugs
-  void detectDependencies(std::ofstream &outputFile)
-  {
-    outputFile << "\n> Dependências de Instruções Recém-Lidas:";
 
-    for (size_t i = 0; i < instructions.size(); i++)
+  // Motores de referência: placar e pipeline em ordem
+  if (options.engine != EngineKind::Tomasulo)
+  {
+    AsyncOutput output(outputFile);
+    std::unique_ptr<Engine> baseline = makeEngine(options.engine, trace, output, format, options.config);
+    baseline->runUntil(options.stopCycle);
+    baseline->finish();
+    if (!output.close())
     {
-      // Only check recently issued instructions
-      if (instructions[i]->isIssued && !instructions[i]->isExecuting && !instructions[i]->isCompleted)
-      {
-        // Check source registers for dependencies
-        std::vector<std::string> dependencyTypes = checkRegisterDependencies(instructions[i]);
-
-        if (!dependencyTypes.empty())
-        {
-          outputFile << "\n Instrução: "
-                     << instructions[i]->op << " "
-                     << instructions[i]->dest << " "
-                     << instructions[i]->src1 << " "
-                     << instructions[i]->src2;
-
-          for (const auto &depType : dependencyTypes)
-          {
-            outputFile << "\n  - " << depType;
-          }
-        }
-      }
+      std::cerr << "Erro ao gravar o arquivo de saída." << std::endl;
+      return 1;
+    }
+    if (!trace.error.empty())
+    {
+      std::cerr << "Erro na " << trace.error << std::endl;
+      return 1;
     }
+    if (!options.statsFormat.empty())
+    {
+      baseline->writeStats(std::cout, options.statsFormat == "json");
+    }
+    return 0;
   }
-  std::vector<std::string> checkRegisterDependencies(Operation *instruction)
-  {
-    std::vector<std::string> dependencies;
 
-    // Check destination register dependencies
-    Register *destReg = getRegister(instruction->dest);
-    if (destReg->busyRead || destReg->busyWrite)
+  // A simulação só escreve na memória; uma thread própria grava (e comprime) a saída
+  AsyncOutput output(outputFile, options.compress);
+  ChromeTraceWriter chrome(output, options.config);
+  std::unique_ptr<Simulator> tomasulo;
+  if (chromeTrace)
+  {
+    tomasulo = std::make_unique<SimulatorModel<BasicScheduler<ChromeTraceObserver>>>(
+        trace, output, format, options.eventDriven, options.config, ChromeTraceObserver{&chrome});
+    chrome.begin();
+  }
+  else
+  {
+    tomasulo = makeSimulator(trace, output, format, options.eventDriven, options.config);
+  }
+  if (!options.restorePath.empty())
+  {
+    std::string error;
+    if (!tomasulo->restore(checkpoint, error))
     {
-      // Only add dependency if the source instruction has not executed
-      if (destReg->instruction &&
-          !(destReg->instruction->isCompleted))
-      {
-        dependencies.push_back("Dependência Falsa (WAR/WAW) no registrador de destino: " + destReg->name);
-      }
+      std::cerr << "Erro: " << error << std::endl;
+      return 1;
     }
-
-    // Check source register 1 dependencies
-    Register *src1Reg = getRegister(instruction->src1);
-    if (src1Reg && (src1Reg->busyRead || src1Reg->busyWrite))
+    if (!tomasulo->resume())
     {
-      // Only add dependency if the source instruction has not executed
-      if (src1Reg->instruction &&
-          !(src1Reg->instruction->isCompleted))
-      {
-        dependencies.push_back("Dependência Verdadeira (RAW) no primeiro registrador fonte: " + src1Reg->name);
-      }
+      std::cerr << "Erro: o arquivo de instruções tem menos instruções que o checkpoint" << std::endl;
+      return 1;
     }
+  }
 
-    // Check source register 2 dependencies
-    Register *src2Reg = getRegister(instruction->src2);
-    if (src2Reg && (src2Reg->busyRead || src2Reg->busyWrite))
+  // Cada checkpoint guarda o estado ao fim do ciclo pedido
+  std::sort(options.saves.begin(), options.saves.end());
+  for (const auto &save : options.saves)
+  {
+    std::string error;
+    if (save.first > options.stopCycle)
     {
-      // Only add dependency if the source instruction has not executed
-      if (src2Reg->instruction &&
-          !(src2Reg->instruction->isCompleted))
-      {
-        dependencies.push_back("Dependência Verdadeira (RAW) no segundo registrador fonte: " + src2Reg->name);
-      }
+      break;
+    }
+    tomasulo->runUntil(save.first);
+    if (tomasulo->cycle() != save.first + 1)
+    {
+      std::cerr << "Aviso: checkpoint '" << save.second << "' não gravado, a simulação não passa pelo ciclo "
+                << save.first << std::endl;
+      continue;
+    }
+    if (!tomasulo->saveCheckpoint(save.second, error))
+    {
+      std::cerr << "Erro: " << error << std::endl;
+      return 1;
     }
-
-    return dependencies;
   }
-};
-
-// Exemplo de uso
-int main(int argc, char *argv[])
-{
-  if (argc < 3)
+  tomasulo->runUntil(options.stopCycle);
+  tomasulo->finish();
+  if (chromeTrace)
   {
-    std::cerr << "Uso: " << argv[0] << " <arquivo_de_instrucoes> <arquivo_de_saida>" << std::endl;
-    return 1;
+    chrome.finish();
   }
-
-  // Leitura das instruções a partir de um arquivo de texto
-  std::vector<Operation *> instructions;
-  std::ifstream input(argv[1]);
-
-  if (!input.is_open())
+  if (!output.close())
   {
-    std::cerr << "Erro ao abrir o arquivo de instruções." << std::endl;
+    std::cerr << "Erro ao gravar o arquivo de saída." << std::endl;
     return 1;
   }
 
-  std::ofstream outputFile(argv[2]);
-  if (!outputFile.is_open())
+  if (!trace.error.empty())
   {
-    std::cerr << "Erro ao abrir o arquivo de saída." << std::endl;
+    std::cerr << "Erro na " << trace.error << std::endl;
     return 1;
   }
 
-  std::string line;
-  while (std::getline(input, line))
+  if (!options.statsFormat.empty())
   {
-    std::istringstream iss(line);
-    std::string op, dest, src1, src2;
-    iss >> op >> dest >> src1 >> src2;
-    instructions.push_back(new Operation(op, dest, src1, src2));
+    tomasulo->writeStats(std::cout, options.statsFormat == "json");
   }
 
-  input.close();
-
-  Scheduler tomasulo(instructions, outputFile);
-  tomasulo.run();
-
   // Fechar o arquivo de saída
   outputFile.close();
 
   return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,209 @@
+#ifndef TOMASULO_ASYNC_OUTPUT_HPP
+#define TOMASULO_ASYNC_OUTPUT_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "lz4.hpp"
+
+const size_t ASYNC_OUTPUT_CHUNK = LZ4_BLOCK_SIZE; // Bytes acumulados antes de entregar um bloco à thread de escrita
+
+/**
+ * @brief Saída com buffer duplo gravada por uma thread própria.
+ *
+ * A simulação escreve apenas na memória, no bloco ativo; quando ele enche, os dois blocos trocam
+ * de papel e a thread de escrita grava o cheio no destino (comprimido como um quadro LZ4, se
+ * pedido) enquanto a simulação preenche o outro. A simulação só espera se a thread ainda estiver
+ * gravando o bloco anterior, ou seja, se o disco for mais lento que a simulação.
+ *
+ * flush() não chega ao destino: os blocos só são gravados quando enchem e em close().
+ */
+class AsyncOutputBuffer : public std::streambuf
+{
+public:
+  AsyncOutputBuffer(std::ostream &sink, bool compress)
+      : sink(sink), compress(compress), active(ASYNC_OUTPUT_CHUNK), pending(ASYNC_OUTPUT_CHUNK), pendingSize(0),
+        writing(false), stopping(false), failed(false), closed(false)
+  {
+    setp(active.data(), active.data() + active.size());
+    writer = std::thread(&AsyncOutputBuffer::writerLoop, this);
+  }
+
+  ~AsyncOutputBuffer()
+  {
+    close();
+  }
+
+  AsyncOutputBuffer(const AsyncOutputBuffer &) = delete;
+  AsyncOutputBuffer &operator=(const AsyncOutputBuffer &) = delete;
+
+  /**
+   * @brief Entrega o que falta, espera a thread de escrita gravar tudo e a encerra.
+   *
+   * @return false se alguma gravação falhou.
+   */
+  bool close()
+  {
+    if (!closed)
+    {
+      handOff();
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+      }
+      wake.notify_all();
+      writer.join();
+      closed = true;
+      setp(nullptr, nullptr);
+    }
+    return !failed;
+  }
+
+protected:
+  int_type overflow(int_type ch) override
+  {
+    if (closed)
+    {
+      return traits_type::eof();
+    }
+    handOff();
+    if (!traits_type::eq_int_type(ch, traits_type::eof()))
+    {
+      *pptr() = traits_type::to_char_type(ch);
+      pbump(1);
+    }
+    return traits_type::not_eof(ch);
+  }
+
+  // Blocos grandes (como os da saída delta) são copiados direto para o bloco ativo
+  std::streamsize xsputn(const char *data, std::streamsize size) override
+  {
+    std::streamsize written = 0;
+    while (written < size && !closed)
+    {
+      if (pptr() == epptr())
+      {
+        handOff();
+      }
+      std::streamsize room = std::min<std::streamsize>(epptr() - pptr(), size - written);
+      std::memcpy(pptr(), data + written, static_cast<size_t>(room));
+      pbump(static_cast<int>(room));
+      written += room;
+    }
+    return written;
+  }
+
+private:
+  std::ostream &sink;
+  bool compress;              // Grava um quadro LZ4 no lugar dos bytes originais
+  std::vector<char> active;   // Bloco sendo preenchido pela simulação
+  std::vector<char> pending;  // Bloco entregue à thread de escrita
+  size_t pendingSize;         // Bytes válidos em `pending`; 0: nada a gravar
+  bool writing;               // A thread de escrita está gravando `pending`
+  bool stopping;              // close() foi chamada; a thread termina depois de gravar o que falta
+  bool failed;                // Alguma gravação falhou
+  bool closed;
+  std::mutex mutex;
+  std::condition_variable wake; // Sinaliza um bloco novo para a thread de escrita ou o fim de uma gravação
+  std::thread writer;
+
+  // Espera a thread de escrita liberar o outro bloco, troca os blocos e entrega o ativo
+  void handOff()
+  {
+    size_t used = static_cast<size_t>(pptr() - pbase());
+    if (used > 0)
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      wake.wait(lock, [this]()
+                { return pendingSize == 0 && !writing; });
+      active.swap(pending);
+      pendingSize = used;
+      lock.unlock();
+      wake.notify_all();
+    }
+    setp(active.data(), active.data() + active.size());
+  }
+
+  void writerLoop()
+  {
+    Lz4FrameWriter frame;
+    std::string compressed;
+    if (compress)
+    {
+      frame.begin(compressed);
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+      wake.wait(lock, [this]()
+                { return pendingSize > 0 || stopping; });
+      if (pendingSize == 0)
+      {
+        break;
+      }
+      size_t size = pendingSize;
+      writing = true;
+      pendingSize = 0;
+      lock.unlock();
+
+      // O bloco pendente só é tocado por esta thread até `writing` voltar a false
+      if (compress)
+      {
+        for (size_t offset = 0; offset < size; offset += LZ4_BLOCK_SIZE)
+        {
+          frame.block(pending.data() + offset, std::min(LZ4_BLOCK_SIZE, size - offset), compressed);
+        }
+        sink.write(compressed.data(), static_cast<std::streamsize>(compressed.size()));
+        compressed.clear();
+      }
+      else
+      {
+        sink.write(pending.data(), static_cast<std::streamsize>(size));
+      }
+
+      lock.lock();
+      writing = false;
+      failed = failed || !sink;
+      wake.notify_all();
+    }
+    lock.unlock();
+
+    if (compress)
+    {
+      frame.end(compressed);
+      sink.write(compressed.data(), static_cast<std::streamsize>(compressed.size()));
+    }
+    sink.flush();
+    std::lock_guard<std::mutex> guard(mutex);
+    failed = failed || !sink;
+  }
+};
+
+// Fluxo de saída sobre um AsyncOutputBuffer, para ser passado no lugar do arquivo de saída
+class AsyncOutput : public std::ostream
+{
+public:
+  AsyncOutput(std::ostream &sink, bool compress = false)
+      : std::ostream(nullptr), buffer(sink, compress)
+  {
+    rdbuf(&buffer);
+  }
+
+  // Grava tudo e encerra a thread de escrita; false se alguma gravação falhou
+  bool close()
+  {
+    return buffer.close();
+  }
+
+private:
+  AsyncOutputBuffer buffer;
+};
+
+#endif
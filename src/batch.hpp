@@ -0,0 +1,180 @@
+#ifndef TOMASULO_BATCH_HPP
+#define TOMASULO_BATCH_HPP
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "config.hpp"
+#include "scheduler.hpp"
+#include "simulator.hpp"
+#include "thread_pool.hpp"
+#include "tracefile.hpp"
+
+// Simulação de um arquivo de instruções no modo em lote
+struct BatchJob
+{
+  std::string input;  // Arquivo de instruções
+  std::string output; // Arquivo de saída da simulação
+  std::string error;  // Vazio se a simulação terminou sem erros
+  int cycles;
+  size_t instructions;
+  double ipc;
+};
+
+/**
+ * @brief Lista os arquivos de instruções de um lote.
+ *
+ * Se a origem for um diretório, usa todos os arquivos comuns dele, em ordem alfabética. Caso
+ * contrário a origem é uma lista com um caminho por linha; linhas vazias ou iniciadas por '#' são
+ * ignoradas e caminhos relativos são relativos ao diretório da lista.
+ *
+ * @param source Diretório ou lista de arquivos.
+ * @param inputs Caminhos dos arquivos de instruções (saída).
+ * @param error Descrição do problema (saída).
+ * @return true se a origem pôde ser lida.
+ */
+inline bool listBatchInputs(const std::string &source, std::vector<std::string> &inputs, std::string &error)
+{
+  namespace fs = std::filesystem;
+  std::error_code ec;
+  if (fs::is_directory(source, ec))
+  {
+    for (const auto &entry : fs::directory_iterator(source, ec))
+    {
+      if (entry.is_regular_file())
+      {
+        inputs.push_back(entry.path().string());
+      }
+    }
+    std::sort(inputs.begin(), inputs.end());
+  }
+  else
+  {
+    std::ifstream manifest(source);
+    if (!manifest.is_open())
+    {
+      error = "erro ao abrir '" + source + "'";
+      return false;
+    }
+    fs::path base = fs::path(source).parent_path();
+    std::string line;
+    while (std::getline(manifest, line))
+    {
+      line.erase(0, line.find_first_not_of(" \t"));
+      line.erase(line.find_last_not_of(" \t\r") + 1);
+      if (line.empty() || line[0] == '#')
+      {
+        continue;
+      }
+      fs::path path(line);
+      inputs.push_back(path.is_absolute() ? path.string() : (base / path).string());
+    }
+  }
+  if (ec)
+  {
+    error = "erro ao ler '" + source + "': " + ec.message();
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Define o arquivo de saída de cada arquivo de instruções.
+ *
+ * A saída tem o nome do arquivo de instruções com a extensão do formato (.txt ou .delta). Arquivos
+ * de diretórios diferentes com o mesmo nome gerariam a mesma saída; os repetidos ficam com erro.
+ */
+inline std::vector<BatchJob> planBatch(const std::vector<std::string> &inputs, const std::string &outputDir,
+                                       OutputFormat format)
+{
+  namespace fs = std::filesystem;
+  std::vector<BatchJob> jobs;
+  std::set<std::string> outputs;
+  for (const auto &input : inputs)
+  {
+    BatchJob job{input, "", "", 0, 0, 0.0};
+    fs::path output = fs::path(outputDir) / fs::path(input).filename();
+    output.replace_extension(format == OutputFormat::Text ? ".txt" : ".delta");
+    job.output = output.string();
+    if (!outputs.insert(job.output).second)
+    {
+      job.error = "saída repetida '" + job.output + "'";
+    }
+    jobs.push_back(job);
+  }
+  return jobs;
+}
+
+// Simula um arquivo de instruções do lote; cada chamada usa apenas seus próprios arquivos e simulador
+inline void runBatchJob(BatchJob &job, OutputFormat format, bool eventDriven, const SchedulerConfig &config)
+{
+  std::unique_ptr<TraceSource> trace = openTrace(job.input, config.registerQnt, job.error);
+  if (!trace)
+  {
+    return;
+  }
+  std::ofstream output(job.output, std::ios::binary);
+  if (!output.is_open())
+  {
+    job.error = "erro ao abrir o arquivo de saída";
+    return;
+  }
+
+  std::unique_ptr<Simulator> simulator = makeSimulator(*trace, output, format, eventDriven, config);
+  simulator->run();
+  job.error = trace->error;
+  job.cycles = simulator->totalCycles();
+  job.instructions = simulator->completedCount();
+  job.ipc = simulator->ipc();
+}
+
+/**
+ * @brief Simula vários arquivos de instruções em paralelo, cada um com seu arquivo de saída.
+ *
+ * No máximo `threads` simulações acontecem ao mesmo tempo; como cada uma lê o arquivo de instruções
+ * sob demanda, a memória usada é limitada pela quantidade de threads e pelo tamanho da janela. O
+ * resumo (ciclos, instruções e IPC ou o erro de cada arquivo) é escrito na ordem do lote.
+ *
+ * @return Quantidade de simulações com erro.
+ */
+inline size_t runBatch(std::vector<BatchJob> &jobs, OutputFormat format, bool eventDriven,
+                       const SchedulerConfig &config, unsigned threads, std::ostream &summary)
+{
+  {
+    WorkStealingPool pool(threads);
+    for (auto &job : jobs)
+    {
+      if (!job.error.empty())
+      {
+        continue;
+      }
+      pool.submit([&job, format, eventDriven, &config]()
+                  { runBatchJob(job, format, eventDriven, config); });
+    }
+    pool.wait();
+  }
+
+  size_t failed = 0;
+  for (const auto &job : jobs)
+  {
+    summary << job.input << ": ";
+    if (job.error.empty())
+    {
+      summary << job.cycles << " ciclos, " << job.instructions << " instruções, IPC " << job.ipc << "\n";
+    }
+    else
+    {
+      summary << job.error << "\n";
+      failed++;
+    }
+  }
+  return failed;
+}
+
+#endif
@@ -0,0 +1,741 @@
+#ifndef TOMASULO_CHECKPOINT_HPP
+#define TOMASULO_CHECKPOINT_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "config.hpp"
+#include "mapped_file.hpp"
+#include "scheduler.hpp"
+#include "tracefile.hpp"
+
+/*
+ * Formato de checkpoint (binário, little-endian)
+ *
+ * Cabeçalho: CheckpointHeader seguido de `sectionCount` entradas CheckpointSection. Cada seção é um
+ * vetor de registros de tamanho fixo, alinhado a 8 bytes, então o arquivo pode ser mapeado em
+ * memória e lido direto, sem decodificação. Os ponteiros para instruções são gravados como a
+ * posição na janela (CHECKPOINT_NONE para nenhum).
+ *
+ * Mudanças no layout de qualquer registro exigem uma nova CHECKPOINT_VERSION. A configuração é
+ * gravada por nome, então novos parâmetros não invalidam checkpoints antigos.
+ */
+const char CHECKPOINT_MAGIC[] = {'T', 'C', 'K', 'P'};
+const std::uint32_t CHECKPOINT_VERSION = 1;
+const std::uint32_t CHECKPOINT_BYTE_ORDER = 0x01020304;
+const std::uint64_t CHECKPOINT_NONE = ~std::uint64_t(0);
+
+enum class CheckpointSectionId : std::uint32_t
+{
+  Config = 1,
+  Core,
+  Window,
+  Units,
+  Stations,
+  Registers,
+  Rat,
+  AliasOf,
+  FreeList,
+  MemoryData,
+  L1Tags,
+  L1Age,
+  L2Tags,
+  L2Age,
+  Lsq,
+  Stats,
+  TempHistogram,
+  UnitAccept
+};
+
+struct CheckpointHeader
+{
+  char magic[4];
+  std::uint32_t version;
+  std::uint32_t byteOrder;    // CHECKPOINT_BYTE_ORDER na ordem de bytes de quem gravou
+  std::uint32_t sectionCount;
+};
+
+struct CheckpointSection
+{
+  std::uint32_t id;          // CheckpointSectionId
+  std::uint32_t recordSize;  // Tamanho de cada registro, conferido na leitura
+  std::uint64_t offset;      // Início da seção no arquivo
+  std::uint64_t count;       // Quantidade de registros
+};
+
+struct ConfigRecord
+{
+  char name[28];
+  std::int32_t value;
+};
+
+// Contadores e estado escalar do Scheduler
+struct CoreRecord
+{
+  std::uint64_t nextIssue;
+  std::uint64_t retired;
+  std::uint64_t completedCount;
+  std::uint64_t lsqHead;
+  std::uint64_t lsqTail;
+  std::int32_t cycle;
+  std::int32_t pendingImm;
+  std::uint8_t pendingOp;
+  std::uint8_t pendingDest;
+  std::uint8_t pendingSrc1;
+  std::uint8_t pendingSrc2;
+  std::uint8_t hasPending;
+  std::uint8_t traceDone;
+  std::uint8_t padding[2];
+};
+
+struct OperationRecord
+{
+  std::uint64_t seq;
+  std::uint64_t memSeq;
+  std::int32_t imm;
+  std::uint8_t op;
+  std::uint8_t dest;
+  std::uint8_t src1;
+  std::uint8_t src2;
+  std::uint8_t physDest;
+  std::uint8_t physSrc[2];
+  std::uint8_t flags; // CHECKPOINT_ISSUED | CHECKPOINT_EXECUTING | CHECKPOINT_COMPLETED
+};
+
+const std::uint8_t CHECKPOINT_ISSUED = 0x01;
+const std::uint8_t CHECKPOINT_EXECUTING = 0x02;
+const std::uint8_t CHECKPOINT_COMPLETED = 0x04;
+
+// Unidades de soma, multiplicação e armazenamento, nessa ordem
+struct UnitRecord
+{
+  std::uint64_t instruction;
+  std::uint64_t busyCycles;
+  std::int32_t remaining;
+  std::uint32_t busy;
+};
+
+// Estações de soma, multiplicação e armazenamento, nessa ordem
+struct StationRecord
+{
+  std::uint64_t operation;
+  std::uint8_t valid;
+  std::uint8_t pendingJ;
+  std::uint8_t pendingK;
+  std::uint8_t qj;
+  std::uint8_t qk;
+  std::uint8_t padding[3];
+};
+
+struct RegisterRecord
+{
+  std::uint64_t instruction;
+  std::int32_t value;
+  std::int32_t readers;
+  std::uint8_t writing;
+  std::uint8_t padding[7];
+};
+
+struct LsqRecord
+{
+  std::uint64_t op;
+  std::int64_t address;
+  std::int32_t value;
+  std::uint8_t isStore;
+  std::uint8_t addressKnown;
+  std::uint8_t completed;
+  std::uint8_t forwarded;
+};
+
+struct StatsRecord
+{
+  std::uint64_t stallCycles[STALL_CAUSE_QNT];
+  std::uint64_t warRenames;
+  std::uint64_t wawRenames;
+  std::uint64_t forwardedLoads;
+  std::uint64_t busyRegisterSum;
+  std::uint64_t l1Hits;
+  std::uint64_t l1Misses;
+  std::uint64_t l2Hits;
+  std::uint64_t l2Misses;
+  std::int32_t busyRegisterPeak;
+  std::int32_t padding;
+};
+
+static_assert(sizeof(CheckpointHeader) == 16 && sizeof(CheckpointSection) == 24 && sizeof(ConfigRecord) == 32 &&
+                  sizeof(CoreRecord) == 56 && sizeof(OperationRecord) == 32 && sizeof(UnitRecord) == 24 &&
+                  sizeof(StationRecord) == 16 && sizeof(RegisterRecord) == 24 && sizeof(LsqRecord) == 24,
+              "layout do checkpoint mudou: atualize CHECKPOINT_VERSION");
+
+// Monta as seções de um checkpoint em memória e as grava de uma vez
+class CheckpointWriter
+{
+public:
+  template <typename T>
+  void add(CheckpointSectionId id, const T *records, size_t count)
+  {
+    static_assert(std::is_trivially_copyable<T>::value, "registros de checkpoint devem ser copiáveis byte a byte");
+    sections.push_back(CheckpointSection{static_cast<std::uint32_t>(id), sizeof(T), data.size(), count});
+    data.append(reinterpret_cast<const char *>(records), count * sizeof(T));
+    data.resize((data.size() + 7) / 8 * 8, '\0');
+  }
+
+  template <typename T>
+  void add(CheckpointSectionId id, const std::vector<T> &records)
+  {
+    add(id, records.data(), records.size());
+  }
+
+  bool write(const std::string &path, std::string &error)
+  {
+    CheckpointHeader header{{}, CHECKPOINT_VERSION, CHECKPOINT_BYTE_ORDER,
+                            static_cast<std::uint32_t>(sections.size())};
+    std::memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic));
+    std::uint64_t base = sizeof(header) + sections.size() * sizeof(CheckpointSection);
+    base = (base + 7) / 8 * 8;
+    for (auto &section : sections)
+    {
+      section.offset += base;
+    }
+
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(sections.data()), sections.size() * sizeof(CheckpointSection));
+    out.write("\0\0\0\0\0\0\0", base - sizeof(header) - sections.size() * sizeof(CheckpointSection));
+    out.write(data.data(), data.size());
+    if (!out)
+    {
+      error = "erro ao gravar o checkpoint '" + path + "'";
+      return false;
+    }
+    return true;
+  }
+
+private:
+  std::vector<CheckpointSection> sections;
+  std::string data;
+};
+
+// Converte um ponteiro para a janela na posição gravada no checkpoint
+template <typename Observer, typename Machine>
+std::uint64_t windowIndex(const BasicScheduler<Observer, Machine> &scheduler, const Operation *op)
+{
+  return op ? static_cast<std::uint64_t>(op - scheduler.window.data()) : CHECKPOINT_NONE;
+}
+
+/**
+ * @brief Grava o estado completo do simulador no início do ciclo atual.
+ *
+ * Inclui a configuração, a janela, unidades, estações, registradores e renomeação, memória, caches,
+ * fila de loads e stores, contadores de desempenho e a posição na fonte de instruções (instruções
+ * já lidas). O estado de saída (arquivo de relatório) não faz parte do checkpoint.
+ */
+template <typename Observer, typename Machine>
+bool saveCheckpoint(const BasicScheduler<Observer, Machine> &scheduler, const std::string &path, std::string &error)
+{
+  CheckpointWriter writer;
+
+  std::vector<ConfigRecord> config;
+  for (const auto &parameter : CONFIG_PARAMETERS)
+  {
+    ConfigRecord record{{}, scheduler.config.*parameter.field};
+    std::strncpy(record.name, parameter.name, sizeof(record.name) - 1);
+    config.push_back(record);
+  }
+  writer.add(CheckpointSectionId::Config, config);
+
+  const Instruction &pending = scheduler.pending;
+  CoreRecord core{scheduler.nextIssue, scheduler.retired, scheduler.completedCount, scheduler.lsq.head,
+                  scheduler.lsq.tail, scheduler.cycle, pending.imm, static_cast<std::uint8_t>(pending.op),
+                  pending.dest, pending.src1, pending.src2, scheduler.hasPending, scheduler.traceDone, {}};
+  writer.add(CheckpointSectionId::Core, &core, 1);
+
+  std::vector<OperationRecord> window;
+  window.reserve(scheduler.window.size());
+  for (const Operation &op : scheduler.window)
+  {
+    std::uint8_t flags = (op.isIssued ? CHECKPOINT_ISSUED : 0) | (op.isExecuting ? CHECKPOINT_EXECUTING : 0) |
+                         (op.isCompleted ? CHECKPOINT_COMPLETED : 0);
+    window.push_back(OperationRecord{op.seq, op.memSeq, op.inst.imm, static_cast<std::uint8_t>(op.inst.op),
+                                     op.inst.dest, op.inst.src1, op.inst.src2, op.physDest,
+                                     {op.physSrc[0], op.physSrc[1]}, flags});
+  }
+  writer.add(CheckpointSectionId::Window, window);
+
+  std::vector<UnitRecord> units;
+  for (const UnitPool *pool : {&scheduler.addUnits, &scheduler.mulUnits, &scheduler.swUnits})
+  {
+    for (size_t i = 0; i < pool->size(); i++)
+    {
+      units.push_back(UnitRecord{windowIndex(scheduler, pool->instruction[i]), pool->busyCycles[i],
+                                 pool->remaining[i], pool->busy.test(i)});
+    }
+  }
+  writer.add(CheckpointSectionId::Units, units);
+
+  std::vector<std::int32_t> accept;
+  for (const UnitPool *pool : {&scheduler.addUnits, &scheduler.mulUnits, &scheduler.swUnits})
+  {
+    accept.insert(accept.end(), pool->nextAccept.begin(), pool->nextAccept.end());
+  }
+  writer.add(CheckpointSectionId::UnitAccept, accept);
+
+  std::vector<StationRecord> stations;
+  for (const ReservationStations *set : {&scheduler.addStations, &scheduler.mulStations, &scheduler.swStations})
+  {
+    for (size_t i = 0; i < set->size(); i++)
+    {
+      stations.push_back(StationRecord{windowIndex(scheduler, set->operation[i]), set->valid.test(i),
+                                       set->pendingJ.test(i), set->pendingK.test(i), set->qj[i], set->qk[i], {}});
+    }
+  }
+  writer.add(CheckpointSectionId::Stations, stations);
+
+  std::vector<RegisterRecord> registers;
+  for (size_t i = 0; i < scheduler.registers.size(); i++)
+  {
+    registers.push_back(RegisterRecord{windowIndex(scheduler, scheduler.registers.instruction[i]),
+                                       scheduler.registers.value[i], scheduler.registers.readers[i],
+                                       scheduler.registers.isWriting(i), {}});
+  }
+  writer.add(CheckpointSectionId::Registers, registers);
+
+  writer.add(CheckpointSectionId::Rat, scheduler.rat);
+  writer.add(CheckpointSectionId::AliasOf, scheduler.aliasOf);
+  writer.add(CheckpointSectionId::FreeList, scheduler.freeList);
+  writer.add(CheckpointSectionId::MemoryData, scheduler.cacheMem);
+  writer.add(CheckpointSectionId::L1Tags, scheduler.memory.l1.tags);
+  writer.add(CheckpointSectionId::L1Age, scheduler.memory.l1.age);
+  writer.add(CheckpointSectionId::L2Tags, scheduler.memory.l2.tags);
+  writer.add(CheckpointSectionId::L2Age, scheduler.memory.l2.age);
+
+  std::vector<LsqRecord> lsq;
+  for (const LsqEntry &entry : scheduler.lsq.entries)
+  {
+    lsq.push_back(LsqRecord{windowIndex(scheduler, entry.op), entry.address, entry.value, entry.isStore,
+                            entry.addressKnown, entry.completed, entry.forwarded});
+  }
+  writer.add(CheckpointSectionId::Lsq, lsq);
+
+  const SchedulerStats &stats = scheduler.stats;
+  StatsRecord statsRecord{{}, stats.warRenames, stats.wawRenames, stats.forwardedLoads, stats.busyRegisterSum,
+                          scheduler.memory.l1.hits, scheduler.memory.l1.misses, scheduler.memory.l2.hits,
+                          scheduler.memory.l2.misses, stats.busyRegisterPeak, 0};
+  std::copy(stats.stallCycles, stats.stallCycles + STALL_CAUSE_QNT, statsRecord.stallCycles);
+  writer.add(CheckpointSectionId::Stats, &statsRecord, 1);
+  writer.add(CheckpointSectionId::TempHistogram, stats.tempHistogram);
+
+  return writer.write(path, error);
+}
+
+/**
+ * @brief Checkpoint mapeado em memória.
+ *
+ * A abertura confere apenas o cabeçalho e a tabela de seções; os registros são lidos direto do
+ * mapeamento ao restaurar.
+ */
+class Checkpoint
+{
+public:
+  bool open(const std::string &path, std::string &error)
+  {
+    if (!file.open(path, error))
+    {
+      return false;
+    }
+    if (file.size < sizeof(CheckpointHeader))
+    {
+      error = "checkpoint inválido";
+      return false;
+    }
+    std::memcpy(&header, file.data, sizeof(header));
+    if (std::memcmp(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic)) != 0)
+    {
+      error = "'" + path + "' não é um checkpoint";
+      return false;
+    }
+    if (header.version != CHECKPOINT_VERSION || header.byteOrder != CHECKPOINT_BYTE_ORDER)
+    {
+      error = "versão ou ordem de bytes do checkpoint não suportada";
+      return false;
+    }
+    if (file.size < sizeof(header) + header.sectionCount * sizeof(CheckpointSection))
+    {
+      error = "checkpoint truncado";
+      return false;
+    }
+    sections = reinterpret_cast<const CheckpointSection *>(file.data + sizeof(header));
+    for (std::uint32_t i = 0; i < header.sectionCount; i++)
+    {
+      const CheckpointSection &section = sections[i];
+      if (section.offset % 8 != 0 || section.offset > file.size ||
+          section.count > (file.size - section.offset) / std::max<std::uint32_t>(section.recordSize, 1))
+      {
+        error = "checkpoint truncado";
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Configuração gravada; parâmetros ausentes no checkpoint ficam com o valor padrão
+  bool readConfig(SchedulerConfig &config, std::string &error) const
+  {
+    size_t count;
+    const ConfigRecord *records = section<ConfigRecord>(CheckpointSectionId::Config, count);
+    if (!records)
+    {
+      error = "checkpoint sem configuração";
+      return false;
+    }
+    config = SchedulerConfig();
+    for (size_t i = 0; i < count; i++)
+    {
+      std::string name(records[i].name, strnlen(records[i].name, sizeof(records[i].name)));
+      const ConfigParameter *parameter = findConfigParameter(name);
+      if (!parameter)
+      {
+        error = "parâmetro desconhecido no checkpoint: " + name;
+        return false;
+      }
+      config.*parameter->field = records[i].value;
+    }
+    return validateConfig(config, error);
+  }
+
+  /**
+   * @brief Restaura o estado gravado em um Scheduler recém-criado com a configuração do checkpoint.
+   *
+   * Depois de restaurar, Scheduler::resume() descarta as instruções já lidas da fonte.
+   */
+  template <typename Observer, typename Machine>
+  bool restore(BasicScheduler<Observer, Machine> &scheduler, std::string &error) const
+  {
+    if (!checkRecords(scheduler, error))
+    {
+      return false;
+    }
+    size_t count;
+    const CoreRecord *core = section<CoreRecord>(CheckpointSectionId::Core, count);
+    const OperationRecord *window = core && count == 1 ? section<OperationRecord>(CheckpointSectionId::Window, count)
+                                                       : nullptr;
+    if (!window || count != scheduler.window.size())
+    {
+      error = "checkpoint incompatível com a configuração";
+      return false;
+    }
+    Operation *base = scheduler.window.data();
+    auto pointer = [base, &scheduler](std::uint64_t index) -> Operation *
+    {
+      return index < scheduler.window.size() ? base + index : nullptr;
+    };
+
+    scheduler.nextIssue = core->nextIssue;
+    scheduler.retired = core->retired;
+    scheduler.completedCount = core->completedCount;
+    scheduler.cycle = core->cycle;
+    scheduler.pending = Instruction{static_cast<OpCode>(core->pendingOp), core->pendingDest, core->pendingSrc1,
+                                    core->pendingSrc2, core->pendingImm};
+    scheduler.hasPending = core->hasPending;
+    scheduler.traceDone = core->traceDone;
+    scheduler.lsq.head = core->lsqHead;
+    scheduler.lsq.tail = core->lsqTail;
+
+    for (size_t i = 0; i < count; i++)
+    {
+      const OperationRecord &record = window[i];
+      Operation &op = scheduler.window[i];
+      op = Operation(Instruction{static_cast<OpCode>(record.op), record.dest, record.src1, record.src2, record.imm});
+      op.seq = record.seq;
+      op.memSeq = record.memSeq;
+      op.physDest = record.physDest;
+      op.physSrc[0] = record.physSrc[0];
+      op.physSrc[1] = record.physSrc[1];
+      op.isIssued = record.flags & CHECKPOINT_ISSUED;
+      op.isExecuting = record.flags & CHECKPOINT_EXECUTING;
+      op.isCompleted = record.flags & CHECKPOINT_COMPLETED;
+    }
+
+    const UnitRecord *units = section<UnitRecord>(CheckpointSectionId::Units, count);
+    size_t next = 0;
+    for (UnitPool *pool : {&scheduler.addUnits, &scheduler.mulUnits, &scheduler.swUnits})
+    {
+      for (size_t i = 0; units && i < pool->size() && next < count; i++, next++)
+      {
+        pool->busy.assign(i, units[next].busy);
+        pool->remaining[i] = units[next].remaining;
+        pool->instruction[i] = pointer(units[next].instruction);
+        pool->busyCycles[i] = units[next].busyCycles;
+      }
+    }
+    if (!units || next != count || count != scheduler.addUnits.size() + scheduler.mulUnits.size() +
+                                                 scheduler.swUnits.size())
+    {
+      error = "checkpoint incompatível com a configuração";
+      return false;
+    }
+
+    // Checkpoints anteriores às unidades pipelinizadas não têm a seção; as unidades aceitam de imediato
+    const std::int32_t *accept = section<std::int32_t>(CheckpointSectionId::UnitAccept, count);
+    next = 0;
+    for (UnitPool *pool : {&scheduler.addUnits, &scheduler.mulUnits, &scheduler.swUnits})
+    {
+      for (size_t i = 0; i < pool->unitCount(); i++, next++)
+      {
+        pool->nextAccept[i] = accept && next < count ? accept[next] : 0;
+      }
+    }
+
+    const StationRecord *stations = section<StationRecord>(CheckpointSectionId::Stations, count);
+    next = 0;
+    for (ReservationStations *set : {&scheduler.addStations, &scheduler.mulStations, &scheduler.swStations})
+    {
+      for (size_t i = 0; stations && i < set->size() && next < count; i++, next++)
+      {
+        const StationRecord &record = stations[next];
+        if (record.valid)
+        {
+          set->reserve(i, pointer(record.operation), record.pendingJ ? record.qj : NO_REGISTER,
+                       record.pendingK ? record.qk : NO_REGISTER);
+          set->qj[i] = record.qj;
+          set->qk[i] = record.qk;
+        }
+      }
+    }
+    if (!stations || next != count || count != scheduler.addStations.size() + scheduler.mulStations.size() +
+                                                    scheduler.swStations.size())
+    {
+      error = "checkpoint incompatível com a configuração";
+      return false;
+    }
+
+    const RegisterRecord *registers = section<RegisterRecord>(CheckpointSectionId::Registers, count);
+    if (!registers || count != scheduler.registers.size())
+    {
+      error = "checkpoint incompatível com a configuração";
+      return false;
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+      scheduler.registers.value[i] = registers[i].value;
+      scheduler.registers.setReaders(i, registers[i].readers);
+      scheduler.registers.setWriting(i, registers[i].writing);
+      scheduler.registers.instruction[i] = pointer(registers[i].instruction);
+    }
+
+    const LsqRecord *lsq = section<LsqRecord>(CheckpointSectionId::Lsq, count);
+    if (!lsq || count != scheduler.lsq.entries.size() ||
+        !copySection(CheckpointSectionId::Rat, scheduler.rat, false) ||
+        !copySection(CheckpointSectionId::AliasOf, scheduler.aliasOf, false) ||
+        !copySection(CheckpointSectionId::FreeList, scheduler.freeList, true) ||
+        !copySection(CheckpointSectionId::MemoryData, scheduler.cacheMem, false) ||
+        !copySection(CheckpointSectionId::L1Tags, scheduler.memory.l1.tags, false) ||
+        !copySection(CheckpointSectionId::L1Age, scheduler.memory.l1.age, false) ||
+        !copySection(CheckpointSectionId::L2Tags, scheduler.memory.l2.tags, false) ||
+        !copySection(CheckpointSectionId::L2Age, scheduler.memory.l2.age, false) ||
+        !copySection(CheckpointSectionId::TempHistogram, scheduler.stats.tempHistogram, true))
+    {
+      error = "checkpoint incompatível com a configuração";
+      return false;
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+      const LsqRecord &record = lsq[i];
+      scheduler.lsq.entries[i] = LsqEntry{pointer(record.op), record.isStore != 0, record.addressKnown != 0,
+                                          record.completed != 0, record.forwarded != 0, record.address,
+                                          record.value};
+    }
+
+    const StatsRecord *stats = section<StatsRecord>(CheckpointSectionId::Stats, count);
+    if (!stats || count != 1)
+    {
+      error = "checkpoint sem contadores de desempenho";
+      return false;
+    }
+    SchedulerStats &target = scheduler.stats;
+    std::copy(stats->stallCycles, stats->stallCycles + STALL_CAUSE_QNT, target.stallCycles);
+    target.warRenames = stats->warRenames;
+    target.wawRenames = stats->wawRenames;
+    target.forwardedLoads = stats->forwardedLoads;
+    target.busyRegisterSum = stats->busyRegisterSum;
+    target.busyRegisterPeak = stats->busyRegisterPeak;
+    scheduler.memory.l1.hits = stats->l1Hits;
+    scheduler.memory.l1.misses = stats->l1Misses;
+    scheduler.memory.l2.hits = stats->l2Hits;
+    scheduler.memory.l2.misses = stats->l2Misses;
+    return true;
+  }
+
+private:
+  MappedFile file;
+  CheckpointHeader header{};
+  const CheckpointSection *sections = nullptr;
+
+  /**
+   * @brief Confere os registros antes de restaurar qualquer estado.
+   *
+   * A abertura confere apenas o cabeçalho; aqui os índices gravados (registradores físicos,
+   * operações, posições na janela e na fila de loads e stores) são comparados com a configuração
+   * do Scheduler, para que um arquivo corrompido seja recusado em vez de indexar fora dos vetores.
+   * A quantidade de registros de cada seção é conferida por restore().
+   */
+  template <typename Observer, typename Machine>
+  bool checkRecords(const BasicScheduler<Observer, Machine> &scheduler, std::string &error) const
+  {
+    const size_t physQnt = scheduler.registers.size();
+    const size_t archQnt = static_cast<size_t>(scheduler.config.archRegisterQnt());
+    const size_t windowSize = scheduler.window.size();
+    auto physical = [physQnt](std::uint8_t reg)
+    {
+      return reg < physQnt || reg == NO_REGISTER;
+    };
+    auto slot = [windowSize](std::uint64_t index)
+    {
+      return index < windowSize;
+    };
+    auto fail = [&error](const char *what)
+    {
+      error = std::string("checkpoint corrompido: ") + what;
+      return false;
+    };
+
+    size_t count;
+    const CoreRecord *core = section<CoreRecord>(CheckpointSectionId::Core, count);
+    if (count != 1)
+    {
+      core = nullptr;
+    }
+    if (core)
+    {
+      Instruction pending{static_cast<OpCode>(core->pendingOp), core->pendingDest, core->pendingSrc1,
+                          core->pendingSrc2, core->pendingImm};
+      if (core->hasPending && !isValidRecord(pending, scheduler.config.registerQnt))
+      {
+        return fail("instrução pendente inválida");
+      }
+      if (core->retired > core->nextIssue || core->nextIssue - core->retired > windowSize ||
+          core->lsqHead > core->lsqTail || core->lsqTail - core->lsqHead > scheduler.lsq.entries.size())
+      {
+        return fail("janela ou fila de loads e stores inconsistente");
+      }
+    }
+
+    const OperationRecord *window = section<OperationRecord>(CheckpointSectionId::Window, count);
+    for (size_t i = 0; window && i < count; i++)
+    {
+      const OperationRecord &record = window[i];
+      Instruction inst{static_cast<OpCode>(record.op), record.dest, record.src1, record.src2, record.imm};
+      if (!isValidRecord(inst, scheduler.config.registerQnt) || !physical(record.physDest) ||
+          !physical(record.physSrc[0]) || !physical(record.physSrc[1]))
+      {
+        return fail("instrução inválida na janela");
+      }
+    }
+
+    const UnitRecord *units = section<UnitRecord>(CheckpointSectionId::Units, count);
+    for (size_t i = 0; units && i < count; i++)
+    {
+      if (units[i].busy && !slot(units[i].instruction))
+      {
+        return fail("unidade ocupada sem instrução");
+      }
+    }
+
+    const StationRecord *stations = section<StationRecord>(CheckpointSectionId::Stations, count);
+    for (size_t i = 0; stations && i < count; i++)
+    {
+      const StationRecord &record = stations[i];
+      if (record.valid && (!slot(record.operation) || !physical(record.qj) || !physical(record.qk)))
+      {
+        return fail("estação de reserva inválida");
+      }
+    }
+
+    const RegisterRecord *registers = section<RegisterRecord>(CheckpointSectionId::Registers, count);
+    for (size_t i = 0; registers && i < count; i++)
+    {
+      if (registers[i].readers < 0)
+      {
+        return fail("registrador com leitores negativos");
+      }
+    }
+
+    const std::uint8_t *rat = section<std::uint8_t>(CheckpointSectionId::Rat, count);
+    for (size_t i = 0; rat && i < count; i++)
+    {
+      if (rat[i] >= physQnt)
+      {
+        return fail("tabela de renomeação inválida");
+      }
+    }
+    const std::uint8_t *aliasOf = section<std::uint8_t>(CheckpointSectionId::AliasOf, count);
+    for (size_t i = 0; aliasOf && i < count; i++)
+    {
+      if (aliasOf[i] >= archQnt && aliasOf[i] != NO_REGISTER)
+      {
+        return fail("registrador de origem de um temporário inválido");
+      }
+    }
+    const std::uint8_t *freeList = section<std::uint8_t>(CheckpointSectionId::FreeList, count);
+    std::vector<bool> listed(physQnt, false);
+    for (size_t i = 0; freeList && i < count; i++)
+    {
+      if (freeList[i] < archQnt || freeList[i] >= physQnt || listed[freeList[i]])
+      {
+        return fail("lista de temporários livres inválida");
+      }
+      listed[freeList[i]] = true;
+    }
+
+    // As posições ocupadas da fila precisam apontar para instruções da janela
+    const LsqRecord *lsq = section<LsqRecord>(CheckpointSectionId::Lsq, count);
+    if (lsq && core && count > 0)
+    {
+      for (std::uint64_t memSeq = core->lsqHead; memSeq < core->lsqTail; memSeq++)
+      {
+        if (!slot(lsq[memSeq % count].op))
+        {
+          return fail("fila de loads e stores inválida");
+        }
+      }
+    }
+    return true;
+  }
+
+  // Registros de uma seção ou nullptr se ela não existir ou tiver outro tamanho de registro
+  template <typename T>
+  const T *section(CheckpointSectionId id, size_t &count) const
+  {
+    for (std::uint32_t i = 0; i < header.sectionCount; i++)
+    {
+      if (sections[i].id == static_cast<std::uint32_t>(id))
+      {
+        count = sections[i].count;
+        return sections[i].recordSize == sizeof(T) ? reinterpret_cast<const T *>(file.data + sections[i].offset)
+                                                   : nullptr;
+      }
+    }
+    count = 0;
+    return nullptr;
+  }
+
+  // Copia uma seção para o vetor; sem `resize` a quantidade precisa ser a do vetor
+  template <typename T>
+  bool copySection(CheckpointSectionId id, std::vector<T> &target, bool resize) const
+  {
+    size_t count;
+    const T *records = section<T>(id, count);
+    if (!records || (!resize && count != target.size()))
+    {
+      return false;
+    }
+    target.assign(records, records + count);
+    return true;
+  }
+};
+
+#endif
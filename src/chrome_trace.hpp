@@ -0,0 +1,231 @@
+#ifndef TOMASULO_CHROME_TRACE_HPP
+#define TOMASULO_CHROME_TRACE_HPP
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "config.hpp"
+#include "instruction.hpp"
+#include "state.hpp"
+
+/**
+ * @brief Linha do tempo da simulação no formato JSON de eventos do Chrome (chrome://tracing, Perfetto).
+ *
+ * Os eventos são gravados à medida que as instruções avançam, a partir dos eventos do observador;
+ * nada é reconstruído do estado por ciclo. Um ciclo corresponde a 1 µs na linha do tempo.
+ *
+ *   processo 1  uma faixa por posição da janela: o tempo de vida de cada instrução, da emissão à
+ *               escrita, dividido em espera na estação, execução e espera pelo CDB
+ *   processo 2  uma faixa por unidade funcional (por estágio, nas pipelinizadas): do despacho à
+ *               liberação da unidade, e contadores de unidades ocupadas e de instruções em voo
+ *
+ * Cada instrução é gravada quando escreve o resultado, então a memória usada é limitada pela janela.
+ */
+class ChromeTraceWriter
+{
+public:
+  ChromeTraceWriter(std::ostream &out, const SchedulerConfig &config)
+      : out(out), registerQnt(config.registerQnt), windowSize(config.windowSize),
+        inFlight(config.windowSize, Lifetime{NO_SEQ, 0, 0, 0, 0, 0}), named(config.windowSize, false), first(true),
+        inFlightCount(0)
+  {
+    const int quant[] = {config.addUnitQnt, config.mulUnitQnt, config.swUnitQnt};
+    const int latency[] = {config.addUnitClock, config.mulUnitClock, config.swUnitClock};
+    const int interval[] = {config.addUnitII, config.mulUnitII, config.swUnitII};
+    int lane = 0;
+    for (int type = 0; type < 3; type++)
+    {
+      int ii = interval[type] > 0 ? interval[type] : latency[type];
+      depth[type] = (latency[type] + ii - 1) / ii;
+      firstLane[type] = lane;
+      lane += quant[type] * depth[type];
+      busy[type] = 0;
+    }
+    firstLane[3] = lane;
+  }
+
+  // Abre o arquivo e nomeia os processos e as faixas das unidades; as da janela são nomeadas no primeiro uso
+  void begin()
+  {
+    out << "{\"traceEvents\":[\n";
+    metadata(1, 0, "process_name", "Janela de instruções");
+    metadata(2, 0, "process_name", "Unidades funcionais");
+    for (int type = 0; type < 3; type++)
+    {
+      for (int slot = 0; slot < firstLane[type + 1] - firstLane[type]; slot++)
+      {
+        std::string name = std::string(UNIT_NAMES[type]) + " " + std::to_string(slot / depth[type]);
+        if (depth[type] > 1)
+        {
+          name += "." + std::to_string(slot % depth[type]);
+        }
+        metadata(2, firstLane[type] + slot, "thread_name", name);
+      }
+    }
+  }
+
+  // Fecha a lista de eventos; o arquivo é JSON válido somente depois desta chamada
+  void finish()
+  {
+    out << "\n]}\n";
+  }
+
+  void issue(int cycle, const Operation &op)
+  {
+    Lifetime &entry = inFlight[op.seq % windowSize];
+    entry = Lifetime{op.seq, cycle, 0, 0, 0, 0};
+    counter(cycle, "Instruções em voo", "instrucoes", ++inFlightCount);
+  }
+
+  void dispatch(int cycle, const Operation &op, UnitType type, size_t unit)
+  {
+    Lifetime *entry = find(op);
+    if (entry)
+    {
+      entry->dispatch = cycle;
+      entry->lane = firstLane[static_cast<int>(type)] + static_cast<int>(unit);
+      entry->type = static_cast<int>(type);
+      counter(cycle, std::string(UNIT_NAMES[entry->type]) + " ocupadas", "unidades", ++busy[entry->type]);
+    }
+  }
+
+  void complete(int cycle, const Operation &op)
+  {
+    Lifetime *entry = find(op);
+    if (entry)
+    {
+      entry->complete = cycle;
+    }
+  }
+
+  // A instrução termina no ciclo da escrita; a unidade é liberada no mesmo ciclo
+  void writeback(int cycle, const Operation &op)
+  {
+    Lifetime *entry = find(op);
+    if (!entry || entry->dispatch == 0)
+    {
+      return;
+    }
+    std::string name = instructionName(op.inst);
+    int slot = static_cast<int>(op.seq % windowSize);
+    if (!named[slot])
+    {
+      metadata(1, slot, "thread_name", "Posição " + std::to_string(slot));
+      named[slot] = true;
+    }
+    slice(1, slot, name, entry->issue, cycle + 1, op.seq);
+    slice(1, slot, "estação de reserva", entry->issue, entry->dispatch, op.seq);
+    slice(1, slot, "execução", entry->dispatch, entry->complete + 1, op.seq);
+    slice(1, slot, "espera do CDB", entry->complete + 1, cycle + 1, op.seq);
+    slice(2, entry->lane, name, entry->dispatch, cycle + 1, op.seq);
+    counter(cycle + 1, std::string(UNIT_NAMES[entry->type]) + " ocupadas", "unidades", --busy[entry->type]);
+    counter(cycle + 1, "Instruções em voo", "instrucoes", --inFlightCount);
+    entry->seq = NO_SEQ;
+  }
+
+private:
+  // Ciclos de uma instrução em voo, guardados na posição da janela que ela ocupa
+  struct Lifetime
+  {
+    size_t seq; // NO_SEQ: posição livre ou instrução emitida antes de um checkpoint restaurado
+    int issue;
+    int dispatch;
+    int complete;
+    int lane;
+    int type;
+  };
+
+  static constexpr size_t NO_SEQ = ~size_t(0);
+  static constexpr const char *UNIT_NAMES[] = {"ADD", "MUL", "SW"};
+
+  std::ostream &out;
+  int registerQnt;
+  int windowSize;
+  std::vector<Lifetime> inFlight; // Instrução emitida em cada posição da janela
+  std::vector<bool> named;        // Faixas da janela que já foram nomeadas
+  int depth[3];                   // Estágios de cada unidade, por tipo
+  int firstLane[4];               // Primeira faixa de unidade de cada tipo (e o total de faixas)
+  int busy[3];                    // Unidades ocupadas de cada tipo
+  bool first;                     // Nenhum evento gravado ainda (controla as vírgulas)
+  int inFlightCount;              // Instruções emitidas e ainda não escritas
+
+  // Registro da instrução ou nullptr se ela foi emitida antes de a gravação começar
+  Lifetime *find(const Operation &op)
+  {
+    Lifetime &entry = inFlight[op.seq % windowSize];
+    return entry.seq == op.seq ? &entry : nullptr;
+  }
+
+  // Instrução no formato do arquivo de entrada (ex: "add F1 F2 F3")
+  std::string instructionName(const Instruction &inst) const
+  {
+    std::string name = OP_NAMES[static_cast<int>(inst.op)];
+    name += " " + registerName(inst.dest, registerQnt) + " ";
+    name += isMemoryOp(inst.op) ? std::to_string(inst.imm) : registerName(inst.src1, registerQnt);
+    return name + " " + registerName(inst.src2, registerQnt);
+  }
+
+  void separator()
+  {
+    out << (first ? "" : ",\n");
+    first = false;
+  }
+
+  void metadata(int pid, int tid, const char *kind, const std::string &name)
+  {
+    separator();
+    out << "{\"name\":\"" << kind << "\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":" << tid
+        << ",\"args\":{\"name\":\"" << name << "\"}}";
+  }
+
+  // Intervalo [start, end) em ciclos; intervalos vazios não são gravados
+  void slice(int pid, int tid, const std::string &name, int start, int end, size_t seq)
+  {
+    if (end <= start)
+    {
+      return;
+    }
+    separator();
+    out << "{\"name\":\"" << name << "\",\"ph\":\"X\",\"pid\":" << pid << ",\"tid\":" << tid << ",\"ts\":" << start
+        << ",\"dur\":" << end - start << ",\"args\":{\"seq\":" << seq << "}}";
+  }
+
+  void counter(int cycle, const std::string &name, const char *series, int value)
+  {
+    separator();
+    out << "{\"name\":\"" << name << "\",\"ph\":\"C\",\"pid\":2,\"ts\":" << cycle << ",\"args\":{\"" << series
+        << "\":" << value << "}}";
+  }
+};
+
+// Observador que repassa os eventos das instruções a um ChromeTraceWriter
+struct ChromeTraceObserver
+{
+  ChromeTraceWriter *writer;
+
+  void issue(int cycle, const Operation &op)
+  {
+    writer->issue(cycle, op);
+  }
+
+  void dispatch(int cycle, const Operation &op, UnitType type, size_t unit)
+  {
+    writer->dispatch(cycle, op, type, unit);
+  }
+
+  void complete(int cycle, const Operation &op)
+  {
+    writer->complete(cycle, op);
+  }
+
+  void writeback(int cycle, const Operation &op)
+  {
+    writer->writeback(cycle, op);
+  }
+
+  void registerWrite(int, std::uint8_t, int) {}
+};
+
+#endif
@@ -0,0 +1,195 @@
+#ifndef TOMASULO_CONFIG_HPP
+#define TOMASULO_CONFIG_HPP
+
+#include <string>
+
+// Constantes de configuração para as unidades funcionais e registradores
+const int ADD_UNIT_CLOCK = 4;
+const int MUL_UNIT_CLOCK = 4;
+const int SW_UNIT_CLOCK = 2;
+// Ciclos entre despachos para a mesma unidade; 0 é a latência (unidade não pipelinizada)
+const int ADD_UNIT_II = 0;
+const int MUL_UNIT_II = 0;
+const int SW_UNIT_II = 0;
+const int ADD_UNIT_QNT = 2;
+const int MUL_UNIT_QNT = 2;
+const int SW_UNIT_QNT = 2;
+const int ADD_RS_QNT = 8;
+const int MUL_RS_QNT = 8;
+const int SW_RS_QNT = 8;
+const int CDB_WIDTH = 2;
+// Instruções emitidas e retiradas por ciclo; COMMIT_WIDTH 0 retira sem limite
+const int ISSUE_WIDTH = 1;
+const int COMMIT_WIDTH = 0;
+const int L1_SETS = 16;
+const int L1_WAYS = 2;
+const int L1_LINE = 16;
+const int L2_SETS = 64;
+const int L2_WAYS = 4;
+const int L2_LINE = 32;
+const int L2_LATENCY = 6;
+const int MEM_LATENCY = 20;
+const int LSQ_SIZE = 16;
+const int REGISTER_QNT = 16;
+const int RENAME_REGISTER_QNT = 16;
+const int WINDOW_SIZE = 1024;
+
+// Registradores arquiteturais (F0..F15 e R0..R15); os temporários de renomeação vêm em seguida
+const int ARCH_REGISTER_QNT = 2 * REGISTER_QNT;
+
+// Índices de registrador cabem em um byte e 0xFF é reservado (NO_REGISTER)
+const int MAX_PHYS_REGISTER_QNT = 255;
+
+// Estado inicial da máquina: valor de todos os registradores e das palavras da memória de dados
+const int INITIAL_REGISTER_VALUE = 1;
+const int MEMORY_WORDS = 32;
+const int INITIAL_MEMORY_VALUE = 2;
+
+// Parâmetros da máquina simulada definidos em tempo de execução; o padrão são as constantes acima
+struct SchedulerConfig
+{
+  int addUnitClock = ADD_UNIT_CLOCK;
+  int mulUnitClock = MUL_UNIT_CLOCK;
+  int swUnitClock = SW_UNIT_CLOCK;
+  int addUnitII = ADD_UNIT_II;
+  int mulUnitII = MUL_UNIT_II;
+  int swUnitII = SW_UNIT_II;
+  int addUnitQnt = ADD_UNIT_QNT;
+  int mulUnitQnt = MUL_UNIT_QNT;
+  int swUnitQnt = SW_UNIT_QNT;
+  int addRsQnt = ADD_RS_QNT;
+  int mulRsQnt = MUL_RS_QNT;
+  int swRsQnt = SW_RS_QNT;
+  int cdbWidth = CDB_WIDTH;
+  int issueWidth = ISSUE_WIDTH;
+  int commitWidth = COMMIT_WIDTH;
+  int l1Sets = L1_SETS;
+  int l1Ways = L1_WAYS;
+  int l1Line = L1_LINE;
+  int l2Sets = L2_SETS;
+  int l2Ways = L2_WAYS;
+  int l2Line = L2_LINE;
+  int l2Latency = L2_LATENCY;
+  int memLatency = MEM_LATENCY;
+  int lsqSize = LSQ_SIZE;
+  int registerQnt = REGISTER_QNT;
+  int renameRegisterQnt = RENAME_REGISTER_QNT;
+  int windowSize = WINDOW_SIZE;
+
+  // Registradores arquiteturais (F e R)
+  constexpr int archRegisterQnt() const
+  {
+    return 2 * registerQnt;
+  }
+};
+
+// Parâmetro configurável, identificado pelo nome da constante correspondente
+struct ConfigParameter
+{
+  const char *name;
+  int SchedulerConfig::*field;
+  int minimum;
+};
+
+const ConfigParameter CONFIG_PARAMETERS[] = {
+    {"ADD_UNIT_CLOCK", &SchedulerConfig::addUnitClock, 1},
+    {"MUL_UNIT_CLOCK", &SchedulerConfig::mulUnitClock, 1},
+    {"SW_UNIT_CLOCK", &SchedulerConfig::swUnitClock, 1},
+    {"ADD_UNIT_II", &SchedulerConfig::addUnitII, 0},
+    {"MUL_UNIT_II", &SchedulerConfig::mulUnitII, 0},
+    {"SW_UNIT_II", &SchedulerConfig::swUnitII, 0},
+    {"ADD_UNIT_QNT", &SchedulerConfig::addUnitQnt, 1},
+    {"MUL_UNIT_QNT", &SchedulerConfig::mulUnitQnt, 1},
+    {"SW_UNIT_QNT", &SchedulerConfig::swUnitQnt, 1},
+    {"ADD_RS_QNT", &SchedulerConfig::addRsQnt, 1},
+    {"MUL_RS_QNT", &SchedulerConfig::mulRsQnt, 1},
+    {"SW_RS_QNT", &SchedulerConfig::swRsQnt, 1},
+    {"CDB_WIDTH", &SchedulerConfig::cdbWidth, 1},
+    {"ISSUE_WIDTH", &SchedulerConfig::issueWidth, 1},
+    {"COMMIT_WIDTH", &SchedulerConfig::commitWidth, 0},
+    {"L1_SETS", &SchedulerConfig::l1Sets, 0},
+    {"L1_WAYS", &SchedulerConfig::l1Ways, 1},
+    {"L1_LINE", &SchedulerConfig::l1Line, 4},
+    {"L2_SETS", &SchedulerConfig::l2Sets, 0},
+    {"L2_WAYS", &SchedulerConfig::l2Ways, 1},
+    {"L2_LINE", &SchedulerConfig::l2Line, 4},
+    {"L2_LATENCY", &SchedulerConfig::l2Latency, 0},
+    {"MEM_LATENCY", &SchedulerConfig::memLatency, 0},
+    {"LSQ_SIZE", &SchedulerConfig::lsqSize, 1},
+    {"REGISTER_QNT", &SchedulerConfig::registerQnt, 1},
+    {"RENAME_REGISTER_QNT", &SchedulerConfig::renameRegisterQnt, 1},
+    {"WINDOW_SIZE", &SchedulerConfig::windowSize, 1},
+};
+
+// Configurações iguais em todos os parâmetros
+inline bool operator==(const SchedulerConfig &a, const SchedulerConfig &b)
+{
+  for (const auto &param : CONFIG_PARAMETERS)
+  {
+    if (a.*param.field != b.*param.field)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Procura um parâmetro pelo nome; retorna nullptr se não existir
+inline const ConfigParameter *findConfigParameter(const std::string &name)
+{
+  for (const auto &param : CONFIG_PARAMETERS)
+  {
+    if (name == param.name)
+    {
+      return &param;
+    }
+  }
+  return nullptr;
+}
+
+/**
+ * @brief Verifica se a configuração pode ser simulada.
+ *
+ * @param config Configuração a verificar.
+ * @param error Descrição do problema encontrado (saída).
+ * @return true se todos os parâmetros são válidos.
+ */
+inline bool validateConfig(const SchedulerConfig &config, std::string &error)
+{
+  for (const auto &param : CONFIG_PARAMETERS)
+  {
+    if (config.*param.field < param.minimum)
+    {
+      error = std::string(param.name) + " deve ser pelo menos " + std::to_string(param.minimum);
+      return false;
+    }
+  }
+  for (const char *name : {"L1_SETS", "L1_LINE", "L2_SETS", "L2_LINE"})
+  {
+    int value = config.*findConfigParameter(name)->field;
+    if ((value & (value - 1)) != 0)
+    {
+      error = std::string(name) + " deve ser uma potência de 2";
+      return false;
+    }
+  }
+  if (config.addUnitII > config.addUnitClock || config.mulUnitII > config.mulUnitClock ||
+      config.swUnitII > config.swUnitClock)
+  {
+    error = "o intervalo de iniciação (*_UNIT_II) deve ser no máximo a latência (*_UNIT_CLOCK)";
+    return false;
+  }
+  if (config.l1Ways > 255 || config.l2Ways > 255)
+  {
+    error = "L1_WAYS e L2_WAYS devem ser no máximo 255";
+    return false;
+  }
+  if (config.archRegisterQnt() + config.renameRegisterQnt > MAX_PHYS_REGISTER_QNT)
+  {
+    error = "2 * REGISTER_QNT + RENAME_REGISTER_QNT deve ser no máximo " + std::to_string(MAX_PHYS_REGISTER_QNT);
+    return false;
+  }
+  return true;
+}
+
+#endif
@@ -0,0 +1,316 @@
+#ifndef TOMASULO_DATAFLOW_HPP
+#define TOMASULO_DATAFLOW_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "config.hpp"
+#include "functional.hpp"
+#include "instruction.hpp"
+#include "stats.hpp"
+
+// Dependências entre instruções encontradas pela análise, separadas por tipo
+struct DependencyCounts
+{
+  std::uint64_t raw = 0; // Verdadeiras: leitura depois de escrita
+  std::uint64_t war = 0; // Antidependências: escrita depois de leitura
+  std::uint64_t waw = 0; // De saída: escrita depois de escrita
+};
+
+// Resultado da análise de fluxo de dados de um programa
+struct DataflowResult
+{
+  std::uint64_t instructions = 0;
+  std::uint64_t unitOps[3] = {0, 0, 0}; // Instruções de cada tipo de unidade (ADD, MUL, SW)
+  DependencyCounts registers;           // Dependências por registrador arquitetural
+  DependencyCounts memory;              // Dependências por posição da memória de dados
+  std::int64_t criticalPath = 0;        // Ciclos da maior cadeia de dependências verdadeiras
+  std::uint64_t criticalLength = 0;     // Instruções nessa cadeia
+  std::uint64_t criticalEnd = 0;        // Posição no programa da última instrução da cadeia
+  std::int64_t scheduleBound = 0;       // Ciclos com recursos ilimitados e a largura de emissão configurada
+  std::int64_t resourceBound = 0;       // Ciclos exigidos pela vazão das unidades funcionais
+  std::int64_t simulatedCycles = -1;    // Ciclos da simulação detalhada ou -1 se não foi simulada
+
+  // Instruções por ciclo no limite do fluxo de dados (recursos e emissão ilimitados)
+  double ilp() const
+  {
+    return criticalPath > 0 ? static_cast<double>(instructions) / criticalPath : 0.0;
+  }
+
+  // Menor quantidade de ciclos possível na configuração: nenhuma simulação termina antes
+  std::int64_t minimumCycles() const
+  {
+    return std::max(scheduleBound, resourceBound);
+  }
+};
+
+/**
+ * @brief Análise de fluxo de dados em uma passada, com memória proporcional aos registradores.
+ *
+ * As arestas do grafo de dependências não são guardadas: para cada registrador arquitetural e cada
+ * posição da memória de dados são mantidos apenas o último escritor (o ciclo em que o valor fica
+ * disponível e a cadeia que o produziu) e quantas instruções leram o valor desde então. Cada
+ * instrução consulta e atualiza essas tabelas em tempo constante, então o programa inteiro custa
+ * O(N). Os endereços de lw e sw são calculados por um FunctionalSimulator executado junto.
+ *
+ * Os ciclos seguem as convenções do Scheduler em uma máquina ideal: estações, unidades, janela,
+ * registradores de renomeação e CDB ilimitados, desambiguação de memória perfeita e todo lw com
+ * acerto na L1. A instrução i é emitida no ciclo i / ISSUE_WIDTH + 1, despacha no ciclo seguinte
+ * ou quando os operandos ficam disponíveis, termina LATÊNCIA - 1 ciclos depois e o resultado
+ * pode ser usado a partir do ciclo seguinte. Só as dependências verdadeiras atrasam instruções; as
+ * falsas (WAR e WAW) são removidas pela renomeação e apenas contadas.
+ */
+class DataflowAnalyzer
+{
+public:
+  DataflowAnalyzer(const SchedulerConfig &config = SchedulerConfig())
+      : functional(config), issueWidth(config.issueWidth), registers(config.archRegisterQnt()),
+        memory(MEMORY_WORDS)
+  {
+    const int quant[] = {config.addUnitQnt, config.mulUnitQnt, config.swUnitQnt};
+    const int latency[] = {config.addUnitClock, config.mulUnitClock, config.swUnitClock};
+    const int interval[] = {config.addUnitII, config.mulUnitII, config.swUnitII};
+    for (int type = 0; type < 3; type++)
+    {
+      unitQnt[type] = quant[type];
+      unitLatency[type] = latency[type];
+      unitII[type] = interval[type] > 0 ? interval[type] : latency[type];
+    }
+  }
+
+  void add(const Instruction &inst)
+  {
+    int type = static_cast<int>(OP_UNIT[static_cast<int>(inst.op)]);
+    std::int64_t issue = static_cast<std::int64_t>(result.instructions / issueWidth) + 1;
+
+    // Operandos lidos: registradores (em sw, o destino é o dado gravado) e, em lw, a posição da memória
+    std::uint8_t reads[2] = {inst.src1, inst.src2};
+    if (inst.op == OpCode::Sw)
+    {
+      reads[0] = inst.dest;
+    }
+    if (reads[0] == reads[1])
+    {
+      reads[1] = NO_REGISTER;
+    }
+    std::int64_t ready = issue + 1;
+    for (std::uint8_t reg : reads)
+    {
+      if (reg != NO_REGISTER)
+      {
+        read(registers[reg], result.registers, ready);
+      }
+    }
+    Chain chain{0, 0};
+    for (std::uint8_t reg : reads)
+    {
+      if (reg != NO_REGISTER)
+      {
+        chain = longer(chain, registers[reg].chain);
+      }
+    }
+
+    size_t word = 0;
+    if (isMemoryOp(inst.op))
+    {
+      int address = performOperation(OpCode::Add, inst.imm, functional.value[inst.src2]);
+      word = static_cast<size_t>(address) % MEMORY_WORDS;
+      if (inst.op == OpCode::Lw)
+      {
+        read(memory[word], result.memory, ready);
+        chain = longer(chain, memory[word].chain);
+      }
+    }
+    functional.step(inst);
+
+    // Término no escalonamento ideal e na cadeia pura (sem o limite de emissão)
+    std::int64_t finish = ready + unitLatency[type] - 1;
+    chain.cycles += unitLatency[type];
+    chain.length++;
+    if (chain.cycles > result.criticalPath)
+    {
+      result.criticalPath = chain.cycles;
+      result.criticalLength = chain.length;
+      result.criticalEnd = result.instructions;
+    }
+    result.scheduleBound = std::max(result.scheduleBound, finish);
+
+    if (inst.op == OpCode::Sw)
+    {
+      write(memory[word], result.memory, false, finish, chain);
+    }
+    else
+    {
+      bool readsDest = inst.dest == reads[0] || inst.dest == reads[1];
+      write(registers[inst.dest], result.registers, readsDest, finish, chain);
+    }
+
+    result.unitOps[type]++;
+    result.instructions++;
+  }
+
+  // Resultado das instruções analisadas até agora
+  DataflowResult finish() const
+  {
+    DataflowResult done = result;
+    for (int type = 0; type < 3; type++)
+    {
+      // A k-ésima aceitação de uma unidade acontece no mínimo (k - 1) * II ciclos depois do primeiro despacho
+      std::uint64_t rounds = (done.unitOps[type] + unitQnt[type] - 1) / unitQnt[type];
+      if (rounds > 0)
+      {
+        std::int64_t last = 2 + static_cast<std::int64_t>(rounds - 1) * unitII[type] + unitLatency[type] - 1;
+        done.resourceBound = std::max(done.resourceBound, last);
+      }
+    }
+    return done;
+  }
+
+private:
+  // Ciclos e instruções da maior cadeia de dependências verdadeiras que termina em uma instrução
+  struct Chain
+  {
+    std::int64_t cycles;
+    std::uint64_t length;
+  };
+
+  // Último escritor de um registrador ou posição de memória
+  struct Location
+  {
+    bool written = false;       // Alguma instrução analisada já escreveu aqui
+    std::int64_t available = 0; // Ciclo em que o valor pode ser usado no escalonamento ideal
+    Chain chain{0, 0};          // Cadeia de dependências verdadeiras que produziu o valor
+    std::uint64_t readers = 0;  // Leituras desde a última escrita
+  };
+
+  FunctionalSimulator functional;  // Valores dos registradores, para os endereços de lw e sw
+  int issueWidth;
+  int unitQnt[3];
+  int unitLatency[3];
+  int unitII[3];                   // Ciclos entre aceitações de uma unidade
+  std::vector<Location> registers; // Indexado pelo registrador arquitetural
+  std::vector<Location> memory;    // Indexado pela posição da memória de dados
+  DataflowResult result;
+
+  static Chain longer(Chain a, const Chain &b)
+  {
+    return b.cycles > a.cycles ? b : a;
+  }
+
+  void read(Location &location, DependencyCounts &counts, std::int64_t &ready)
+  {
+    if (location.written)
+    {
+      counts.raw++;
+      ready = std::max(ready, location.available);
+    }
+    location.readers++;
+  }
+
+  // `selfRead`: a própria instrução leu o local antes de escrevê-lo, o que não é antidependência
+  void write(Location &location, DependencyCounts &counts, bool selfRead, std::int64_t finish, Chain chain)
+  {
+    counts.war += location.readers - (selfRead ? 1 : 0);
+    counts.waw += location.written;
+    location.written = true;
+    location.available = finish + 1;
+    location.chain = chain;
+    location.readers = 0;
+  }
+};
+
+// Fonte que repassa cada instrução entregue ao analisador, para analisar durante a simulação
+class DataflowTrace : public TraceSource
+{
+public:
+  TraceSource &source;
+  DataflowAnalyzer &analyzer;
+
+  DataflowTrace(TraceSource &source, DataflowAnalyzer &analyzer)
+      : source(source), analyzer(analyzer) {}
+
+  bool next(Instruction &inst) override
+  {
+    if (!source.next(inst))
+    {
+      error = source.error;
+      return false;
+    }
+    analyzer.add(inst);
+    return true;
+  }
+};
+
+// Analisa todas as instruções da fonte
+inline DataflowResult analyzeDataflow(TraceSource &trace, const SchedulerConfig &config)
+{
+  DataflowAnalyzer analyzer(config);
+  Instruction inst;
+  while (trace.next(inst))
+  {
+    analyzer.add(inst);
+  }
+  return analyzer.finish();
+}
+
+// Escreve o resultado da análise de fluxo de dados como texto ou JSON
+inline void writeDataflowReport(std::ostream &out, const DataflowResult &result, bool json)
+{
+  const char *const typeNames[] = {"add", "mul", "sw"};
+  if (json)
+  {
+    out << "{\"instrucoes\":" << result.instructions << ",\"por_unidade\":{";
+    for (int type = 0; type < 3; type++)
+    {
+      out << (type ? "," : "") << "\"" << typeNames[type] << "\":" << result.unitOps[type];
+    }
+    out << "},\"registradores\":{\"raw\":" << result.registers.raw << ",\"war\":" << result.registers.war
+        << ",\"waw\":" << result.registers.waw << "},\"memoria\":{\"raw\":" << result.memory.raw
+        << ",\"war\":" << result.memory.war << ",\"waw\":" << result.memory.waw
+        << "},\"caminho_critico\":{\"ciclos\":" << result.criticalPath << ",\"instrucoes\":" << result.criticalLength
+        << ",\"ultima_instrucao\":" << result.criticalEnd << "},\"ilp\":" << result.ilp()
+        << ",\"limite_emissao\":" << result.scheduleBound << ",\"limite_unidades\":" << result.resourceBound
+        << ",\"ciclos_minimos\":" << result.minimumCycles();
+    if (result.simulatedCycles >= 0)
+    {
+      out << ",\"ciclos_simulados\":" << result.simulatedCycles;
+    }
+    out << "}\n";
+    return;
+  }
+
+  out << "> Fluxo de dados\n";
+  writeLabel(out, "Instruções") << result.instructions << "\n";
+  writeLabel(out, "Instruções por unidade (ADD/MUL/SW)")
+      << result.unitOps[0] << " / " << result.unitOps[1] << " / " << result.unitOps[2] << "\n";
+  writeLabel(out, "Dependências RAW (registrador/memória)")
+      << result.registers.raw << " / " << result.memory.raw << "\n";
+  writeLabel(out, "Dependências WAR (registrador/memória)")
+      << result.registers.war << " / " << result.memory.war << "\n";
+  writeLabel(out, "Dependências WAW (registrador/memória)")
+      << result.registers.waw << " / " << result.memory.waw << "\n";
+
+  out << "\n> Limites\n" << std::fixed << std::setprecision(2);
+  writeLabel(out, "Caminho crítico (ciclos)") << result.criticalPath << "\n";
+  writeLabel(out, "Instruções no caminho crítico") << result.criticalLength << " (última: "
+                                                   << result.criticalEnd << ")\n";
+  writeLabel(out, "ILP do fluxo de dados") << result.ilp() << "\n";
+  writeLabel(out, "Limite com a largura de emissão") << result.scheduleBound << " ciclos\n";
+  writeLabel(out, "Limite das unidades funcionais") << result.resourceBound << " ciclos\n";
+  writeLabel(out, "Mínimo teórico") << result.minimumCycles() << " ciclos\n";
+  if (result.simulatedCycles >= 0)
+  {
+    writeLabel(out, "Ciclos simulados") << result.simulatedCycles << "\n";
+    if (result.simulatedCycles > 0)
+    {
+      writeLabel(out, "Eficiência (mínimo / simulado)")
+          << 100.0 * result.minimumCycles() / result.simulatedCycles << "%\n";
+    }
+  }
+  out << std::defaultfloat << std::setprecision(6);
+}
+
+#endif
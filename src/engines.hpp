@@ -0,0 +1,817 @@
+#ifndef TOMASULO_ENGINES_HPP
+#define TOMASULO_ENGINES_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "config.hpp"
+#include "functional.hpp"
+#include "instruction.hpp"
+#include "memory.hpp"
+#include "report.hpp"
+#include "simulator.hpp"
+#include "state.hpp"
+#include "stats.hpp"
+#include "thread_pool.hpp"
+#include "tracefile.hpp"
+
+// Motores de escalonamento disponíveis, do mais simples ao Tomasulo
+enum class EngineKind : std::uint8_t
+{
+  InOrder,    // Pipeline em ordem: a execução começa na ordem do programa
+  Scoreboard, // Placar do CDC 6600: execução fora de ordem, sem renomeação
+  Tomasulo    // Algoritmo de Tomasulo, com estações de reserva e renomeação
+};
+
+const int ENGINE_QNT = 3;
+
+const char *const ENGINE_NAMES[ENGINE_QNT] = {"em-ordem", "placar", "tomasulo"};
+
+inline bool parseEngineKind(const std::string &name, EngineKind &kind)
+{
+  for (int i = 0; i < ENGINE_QNT; i++)
+  {
+    if (name == ENGINE_NAMES[i])
+    {
+      kind = static_cast<EngineKind>(i);
+      return true;
+    }
+  }
+  return false;
+}
+
+// Riscos que impedem uma instrução de avançar nos motores de referência
+enum class Hazard : std::uint8_t
+{
+  Structural,  // Sem unidade funcional livre do tipo da instrução
+  Raw,         // Operando ainda não escrito
+  Waw,         // Destino com escrita pendente de uma instrução anterior
+  War,         // Resultado pronto esperando uma instrução anterior ler o registrador de destino
+  MemoryOrder, // lw esperando um sw anterior para a mesma posição
+  Cdb          // Resultado pronto esperando vaga no barramento de resultados
+};
+
+const int HAZARD_QNT = 6;
+
+// Nomes usados no JSON e descrições usadas no resumo, indexados por Hazard
+const char *const HAZARD_NAMES[HAZARD_QNT] = {"estrutural", "raw", "waw", "war", "ordem_memoria", "cdb"};
+const char *const HAZARD_DESCRIPTIONS[HAZARD_QNT] = {
+    "Estrutural (sem unidade livre)",
+    "Dependência verdadeira (RAW)",
+    "Dependência de saída (WAW)",
+    "Antidependência (WAR)",
+    "Ordem de memória (sw anterior)",
+    "Barramento comum (CDB) ocupado",
+};
+
+// Ciclos em que cada risco ocorreu pelo menos uma vez, como em SchedulerStats
+struct HazardStats
+{
+  std::uint64_t cycles[HAZARD_QNT] = {};
+  bool cycleHazard[HAZARD_QNT] = {};
+
+  void beginCycle()
+  {
+    for (bool &hazard : cycleHazard)
+    {
+      hazard = false;
+    }
+  }
+
+  void hazard(Hazard cause)
+  {
+    cycleHazard[static_cast<int>(cause)] = true;
+  }
+
+  void endCycle()
+  {
+    for (int i = 0; i < HAZARD_QNT; i++)
+    {
+      cycles[i] += cycleHazard[i];
+    }
+  }
+};
+
+// Instrução em voo em um motor de referência; sem renomeação os registradores são os arquiteturais
+struct PipelineOp
+{
+  Instruction inst;
+  size_t seq;                // Posição da instrução no programa
+  std::uint8_t dest;         // Registrador escrito (NO_REGISTER em sw)
+  std::uint8_t src[2];       // Registradores lidos (NO_REGISTER quando não se aplica)
+  size_t word;               // Posição da memória de dados acessada por lw e sw
+  std::uint64_t waitFor[3];  // Produtor ainda não escrito de cada operando e, em lw, do dado (seq + 1; 0: pronto)
+  int issued;                // Ciclo de emissão
+  int started;               // Ciclo de início da execução (0: esperando os operandos)
+  int ended;                 // Ciclo de fim da execução (0: executando)
+};
+
+// Unidades funcionais de um tipo com a instrução que ocupa cada posição
+struct PipelineUnits
+{
+  UnitPool pool;
+  std::vector<PipelineOp> operation;
+
+  PipelineUnits(UnitType type, int latency, int quant, int initiationInterval)
+      : pool(type, latency, quant, initiationInterval), operation(pool.size()) {}
+};
+
+/**
+ * @brief Base dos motores de referência (placar e pipeline em ordem).
+ *
+ * Usa as mesmas unidades funcionais (quantidade, latência e intervalo de iniciação), caches,
+ * largura de emissão e barramento de resultados (CDB_WIDTH) do Tomasulo, e a mesma convenção de
+ * tempo: uma instrução emitida em um ciclo começa a executar no seguinte, termina depois da latência
+ * e escreve o resultado no ciclo em que termina, liberando os dependentes para o ciclo seguinte. Os
+ * valores e endereços vêm de uma execução funcional feita na emissão, em ordem de programa; o motor
+ * modela apenas o tempo.
+ *
+ * Cada ciclo tem os estágios de início da execução e de emissão, que variam com o motor, seguidos
+ * da execução e da escrita dos resultados.
+ */
+class PipelineEngine : public Engine
+{
+public:
+  const char *engineName;              // Nome do motor nos relatórios
+  SchedulerConfig config;
+  TraceSource &trace;
+  std::ostream &outputFile;
+  OutputFormat format;                 // Texto (uma linha por instrução escrita) ou nenhum
+  PipelineUnits units[3];              // Unidades ADD, MUL e SW
+  FunctionalSimulator functional;      // Valores dos registradores e da memória em ordem de programa
+  MemoryHierarchy memory;              // Caches L1/L2, usadas para o tempo de lw e sw
+  std::vector<std::uint64_t> writer;   // Instrução em voo que escreve cada registrador (seq + 1; 0: nenhuma)
+  std::vector<std::uint64_t> storer;   // sw em voo mais recente para cada posição da memória (seq + 1; 0: nenhum)
+  size_t nextSeq;                      // Número de sequência da próxima instrução emitida
+  size_t completed;                    // Instruções que escreveram o resultado
+  Instruction pending;                 // Próxima instrução já lida, aguardando emissão
+  bool hasPending;
+  bool traceDone;
+  int currentCycle;
+  HazardStats stats;
+
+  PipelineEngine(const char *engineName, TraceSource &trace, std::ostream &outputFile, OutputFormat format,
+                 const SchedulerConfig &config)
+      : engineName(engineName), config(config), trace(trace), outputFile(outputFile), format(format),
+        units{PipelineUnits(UnitType::Add, config.addUnitClock, config.addUnitQnt, config.addUnitII),
+              PipelineUnits(UnitType::Mul, config.mulUnitClock, config.mulUnitQnt, config.mulUnitII),
+              PipelineUnits(UnitType::Sw, config.swUnitClock, config.swUnitQnt, config.swUnitII)},
+        functional(config), memory(config), writer(config.archRegisterQnt(), 0), storer(MEMORY_WORDS, 0),
+        nextSeq(0), completed(0), pending(), hasPending(false), traceDone(false), currentCycle(1)
+  {
+    finished.reserve(units[0].pool.size() + units[1].pool.size() + units[2].pool.size());
+    if (format == OutputFormat::Text)
+    {
+      outputFile << "Motor " << engineName << "\n\n"
+                 << "#       Instrução                  Emissão    Início       Fim   Escrita\n";
+    }
+  }
+
+  bool runUntil(int lastCycle) override
+  {
+    while (!isExecutionComplete() && currentCycle <= lastCycle)
+    {
+      stats.beginCycle();
+      start();
+      issue();
+      execute();
+      write();
+      stats.endCycle();
+      currentCycle++;
+    }
+    return isExecutionComplete();
+  }
+
+  bool step() override
+  {
+    return !runUntil(currentCycle);
+  }
+
+  void run() override
+  {
+    runUntil(std::numeric_limits<int>::max() - 1);
+    finish();
+  }
+
+  void finish() override
+  {
+    if (format == OutputFormat::Text && isExecutionComplete())
+    {
+      outputFile << "\nExecução completa\n";
+    }
+  }
+
+  bool isExecutionComplete() const override
+  {
+    return traceDone && !hasPending && completed == nextSeq;
+  }
+
+  int cycle() const override
+  {
+    return currentCycle;
+  }
+
+  int totalCycles() const override
+  {
+    return currentCycle - 1;
+  }
+
+  size_t completedCount() const override
+  {
+    return completed;
+  }
+
+  double ipc() const override
+  {
+    return totalCycles() > 0 ? static_cast<double>(completed) / totalCycles() : 0.0;
+  }
+
+  void writeStats(std::ostream &out, bool json) const override
+  {
+    if (json)
+    {
+      writeJson(out);
+    }
+    else
+    {
+      writeSummary(out);
+    }
+  }
+
+protected:
+  // Começa a executar as instruções que já podem (estágio que distingue os motores)
+  virtual void start() = 0;
+
+  // Emite as próximas instruções do programa
+  virtual void issue() = 0;
+
+  // Indica se a instrução que terminou de executar pode escrever o resultado neste ciclo
+  virtual bool canWrite(const PipelineOp &op) const = 0;
+
+  // Lê a próxima instrução da fonte, se ainda não houver uma aguardando; false no fim do programa
+  bool fetch()
+  {
+    if (!hasPending && !traceDone)
+    {
+      hasPending = trace.next(pending);
+      traceDone = !hasPending;
+    }
+    return hasPending;
+  }
+
+  PipelineUnits &unitsOf(const Instruction &inst)
+  {
+    return units[static_cast<int>(OP_UNIT[static_cast<int>(inst.op)])];
+  }
+
+  /**
+   * @brief Emite a instrução aguardando: registradores lidos e escritos e, em lw e sw, a posição da
+   * memória, calculada pela execução funcional.
+   */
+  PipelineOp take()
+  {
+    PipelineOp op{};
+    op.inst = pending;
+    op.seq = nextSeq++;
+    op.dest = pending.op == OpCode::Sw ? NO_REGISTER : pending.dest;
+    op.src[0] = pending.op == OpCode::Sw ? pending.dest : pending.src1;
+    op.src[1] = pending.src2;
+    if (isMemoryOp(pending.op))
+    {
+      int address = performOperation(OpCode::Add, pending.imm, functional.value[pending.src2]);
+      op.word = static_cast<size_t>(address) % MEMORY_WORDS;
+    }
+    op.issued = currentCycle;
+    functional.step(pending);
+    hasPending = false;
+    return op;
+  }
+
+  // Indica se a unidade da posição aceita uma instrução neste ciclo (intervalo de iniciação)
+  bool accepts(const UnitPool &pool, size_t position) const
+  {
+    return pool.nextAccept[position / pool.depth] <= currentCycle;
+  }
+
+  // Posição livre em uma unidade que aceita instruções neste ciclo ou pool.size()
+  size_t findAvailable(const UnitPool &pool) const
+  {
+    for (size_t unit = 0; unit < pool.unitCount(); unit++)
+    {
+      if (pool.nextAccept[unit] > currentCycle)
+      {
+        continue;
+      }
+      for (size_t i = unit * pool.depth; i < (unit + 1) * pool.depth; i++)
+      {
+        if (!pool.busy.test(i))
+        {
+          return i;
+        }
+      }
+    }
+    return pool.size();
+  }
+
+  // Inicia a execução da instrução da posição; lw acessa as caches
+  void begin(PipelineUnits &group, size_t position)
+  {
+    UnitPool &pool = group.pool;
+    PipelineOp &op = group.operation[position];
+    int latency = op.inst.op == OpCode::Lw ? pool.latency + memory.access(static_cast<std::int64_t>(op.word))
+                                           : pool.latency;
+    pool.remaining[position] = latency;
+    pool.nextAccept[position / pool.depth] = currentCycle + pool.initiationInterval;
+    op.started = currentCycle;
+  }
+
+  // Decrementa os ciclos restantes das instruções em execução
+  void execute()
+  {
+    for (PipelineUnits &group : units)
+    {
+      UnitPool &pool = group.pool;
+      pool.busy.forEachSet([this, &group, &pool](size_t i)
+                           {
+                             pool.busyCycles[i]++;
+                             PipelineOp &op = group.operation[i];
+                             if (op.started && !op.ended && --pool.remaining[i] == 0)
+                             {
+                               op.ended = currentCycle;
+                             } });
+    }
+  }
+
+  /**
+   * @brief Escreve os resultados das instruções que terminaram, no máximo CDB_WIDTH por ciclo,
+   * as mais antigas primeiro.
+   */
+  void write()
+  {
+    finished.clear();
+    for (PipelineUnits &group : units)
+    {
+      group.pool.busy.forEachSet([this, &group](size_t i)
+                                 {
+                                   const PipelineOp &op = group.operation[i];
+                                   if (!op.ended)
+                                   {
+                                     return;
+                                   }
+                                   if (canWrite(op))
+                                   {
+                                     finished.emplace_back(&group, i);
+                                   }
+                                   else
+                                   {
+                                     stats.hazard(Hazard::War);
+                                   } });
+    }
+    size_t slots = static_cast<size_t>(config.cdbWidth);
+    if (finished.size() > slots)
+    {
+      stats.hazard(Hazard::Cdb);
+      std::nth_element(finished.begin(), finished.begin() + slots, finished.end(),
+                       [](const std::pair<PipelineUnits *, size_t> &a, const std::pair<PipelineUnits *, size_t> &b)
+                       { return a.first->operation[a.second].seq < b.first->operation[b.second].seq; });
+      finished.resize(slots);
+    }
+    for (const auto &candidate : finished)
+    {
+      complete(*candidate.first, candidate.second);
+    }
+  }
+
+  // Escreve o resultado, libera a posição e acorda as instruções que esperavam por ela
+  void complete(PipelineUnits &group, size_t position)
+  {
+    const PipelineOp &op = group.operation[position];
+    std::uint64_t tag = op.seq + 1;
+    if (op.dest != NO_REGISTER && writer[op.dest] == tag)
+    {
+      writer[op.dest] = 0;
+    }
+    if (op.inst.op == OpCode::Sw)
+    {
+      if (storer[op.word] == tag)
+      {
+        storer[op.word] = 0;
+      }
+      memory.access(static_cast<std::int64_t>(op.word));
+    }
+    for (PipelineUnits &other : units)
+    {
+      other.pool.busy.forEachSet([&other, tag](size_t i)
+                                 {
+                                   for (std::uint64_t &producer : other.operation[i].waitFor)
+                                   {
+                                     if (producer == tag)
+                                     {
+                                       producer = 0;
+                                     }
+                                   } });
+    }
+    if (format == OutputFormat::Text)
+    {
+      std::ostringstream text;
+      writeInstruction(text, op.inst, config.registerQnt);
+      outputFile << std::left << std::setw(8) << op.seq << std::setw(24) << text.str() << std::right
+                 << std::setw(10) << op.issued << std::setw(10) << op.started << std::setw(10) << op.ended
+                 << std::setw(10) << currentCycle << "\n";
+    }
+    group.pool.busy.reset(position);
+    completed++;
+  }
+
+private:
+  std::vector<std::pair<PipelineUnits *, size_t>> finished; // Candidatos à escrita no ciclo atual
+
+  void writeSummary(std::ostream &out) const
+  {
+    int cycles = totalCycles();
+    out << "> Estatísticas (motor " << engineName << ")\n" << std::fixed;
+    writeLabel(out, "Ciclos") << cycles << "\n";
+    writeLabel(out, "Instruções concluídas") << completed << "\n";
+    writeLabel(out, "IPC") << std::setprecision(3) << ipc() << "\n";
+
+    out << "\n> Ocupação das unidades funcionais\n";
+    const char *names[] = {"ADD", "MUL", "SW"};
+    for (int g = 0; g < 3; g++)
+    {
+      const UnitPool &pool = units[g].pool;
+      for (size_t i = 0; i < pool.unitCount(); i++)
+      {
+        writeLabel(out, std::string(names[g]) + " " + std::to_string(i)) << pool.unitBusyCycles(i) << " ciclos ("
+            << std::setprecision(1) << 100.0 * unitUtilization(pool, i, cycles) << "%)\n";
+      }
+    }
+
+    out << "\n> Ciclos parados por causa\n";
+    for (int i = 0; i < HAZARD_QNT; i++)
+    {
+      writeLabel(out, HAZARD_DESCRIPTIONS[i]) << stats.cycles[i] << "\n";
+    }
+
+    out << "\n> Memória\n";
+    writeLabel(out, "L1 (acertos / faltas)") << memory.l1.hits << " / " << memory.l1.misses << "\n";
+    writeLabel(out, "L2 (acertos / faltas)") << memory.l2.hits << " / " << memory.l2.misses << "\n";
+    out << std::defaultfloat << std::setprecision(6);
+  }
+
+  void writeJson(std::ostream &out) const
+  {
+    int cycles = totalCycles();
+    out << "{\"motor\":\"" << engineName << "\",\"ciclos\":" << cycles << ",\"instrucoes\":" << completed
+        << ",\"ipc\":" << ipc() << ",\"unidades\":{";
+    const char *names[] = {"ADD", "MUL", "SW"};
+    for (int g = 0; g < 3; g++)
+    {
+      const UnitPool &pool = units[g].pool;
+      out << (g ? "," : "") << "\"" << names[g] << "\":[";
+      for (size_t i = 0; i < pool.unitCount(); i++)
+      {
+        out << (i ? "," : "") << "{\"ocupada\":" << pool.unitBusyCycles(i)
+            << ",\"utilizacao\":" << unitUtilization(pool, i, cycles) << "}";
+      }
+      out << "]";
+    }
+    out << "},\"paradas\":{";
+    for (int i = 0; i < HAZARD_QNT; i++)
+    {
+      out << (i ? "," : "") << "\"" << HAZARD_NAMES[i] << "\":" << stats.cycles[i];
+    }
+    out << "},\"memoria\":{\"l1\":{\"acertos\":" << memory.l1.hits << ",\"faltas\":" << memory.l1.misses
+        << "},\"l2\":{\"acertos\":" << memory.l2.hits << ",\"faltas\":" << memory.l2.misses << "}}}\n";
+  }
+};
+
+/**
+ * @brief Placar (scoreboard) do CDC 6600: execução fora de ordem sem renomeação.
+ *
+ * A emissão é em ordem e reserva uma posição de unidade funcional, que fica ocupada até a escrita
+ * (não há estações de reserva): para se não houver posição livre ou se outra instrução em voo
+ * escreve o mesmo registrador (WAW). Os operandos são lidos quando seus produtores escrevem (RAW),
+ * e a execução começa se a unidade aceitar. Um resultado pronto só é escrito depois que todas as
+ * instruções anteriores que leem o registrador de destino começaram a executar (WAR). lw espera o
+ * sw anterior para a mesma posição da memória, e um sw só escreve depois dos lw anteriores para ela.
+ */
+class ScoreboardEngine final : public PipelineEngine
+{
+public:
+  ScoreboardEngine(TraceSource &trace, std::ostream &outputFile, OutputFormat format, const SchedulerConfig &config)
+      : PipelineEngine(ENGINE_NAMES[static_cast<int>(EngineKind::Scoreboard)], trace, outputFile, format, config)
+  {
+    order.reserve(units[0].pool.size() + units[1].pool.size() + units[2].pool.size());
+  }
+
+protected:
+  // Lê os operandos e inicia a execução das instruções prontas, as mais antigas primeiro
+  void start() override
+  {
+    for (PipelineUnits &group : units)
+    {
+      order.clear();
+      group.pool.busy.forEachSet([this, &group](size_t i)
+                                 {
+                                   if (!group.operation[i].started)
+                                   {
+                                     order.push_back(i);
+                                   } });
+      std::sort(order.begin(), order.end(), [&group](size_t a, size_t b)
+                { return group.operation[a].seq < group.operation[b].seq; });
+      for (size_t i : order)
+      {
+        const PipelineOp &op = group.operation[i];
+        if (op.waitFor[0] || op.waitFor[1])
+        {
+          stats.hazard(Hazard::Raw);
+        }
+        else if (op.waitFor[2])
+        {
+          stats.hazard(Hazard::MemoryOrder);
+        }
+        else if (!accepts(group.pool, i))
+        {
+          stats.hazard(Hazard::Structural);
+        }
+        else
+        {
+          begin(group, i);
+        }
+      }
+    }
+  }
+
+  // Emite em ordem até ISSUE_WIDTH instruções, cada uma em uma posição livre da sua unidade
+  void issue() override
+  {
+    for (int issued = 0; issued < config.issueWidth && fetch(); issued++)
+    {
+      PipelineUnits &group = unitsOf(pending);
+      size_t position = group.pool.busy.findFirstClear();
+      if (position == group.pool.size())
+      {
+        stats.hazard(Hazard::Structural);
+        return;
+      }
+      if (pending.op != OpCode::Sw && writer[pending.dest])
+      {
+        stats.hazard(Hazard::Waw);
+        return;
+      }
+
+      PipelineOp op = take();
+      for (int k = 0; k < 2; k++)
+      {
+        op.waitFor[k] = op.src[k] != NO_REGISTER ? writer[op.src[k]] : 0;
+      }
+      if (op.inst.op == OpCode::Lw)
+      {
+        op.waitFor[2] = storer[op.word];
+      }
+      else if (op.inst.op == OpCode::Sw)
+      {
+        storer[op.word] = op.seq + 1;
+      }
+      if (op.dest != NO_REGISTER)
+      {
+        writer[op.dest] = op.seq + 1;
+      }
+      group.operation[position] = op;
+      group.pool.busy.set(position);
+    }
+  }
+
+  // WAR: alguma instrução anterior que ainda não leu os operandos lê o destino desta
+  bool canWrite(const PipelineOp &op) const override
+  {
+    for (const PipelineUnits &group : units)
+    {
+      bool blocked = false;
+      group.pool.busy.forEachSet([&group, &op, &blocked](size_t i)
+                                 {
+                                   const PipelineOp &older = group.operation[i];
+                                   if (older.started || older.seq >= op.seq)
+                                   {
+                                     return;
+                                   }
+                                   if (op.dest != NO_REGISTER && (older.src[0] == op.dest || older.src[1] == op.dest))
+                                   {
+                                     blocked = true;
+                                   }
+                                   if (op.inst.op == OpCode::Sw && older.inst.op == OpCode::Lw && older.word == op.word)
+                                   {
+                                     blocked = true;
+                                   } });
+      if (blocked)
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+private:
+  std::vector<size_t> order; // Posições esperando operandos, em ordem de programa
+};
+
+/**
+ * @brief Pipeline com emissão e início da execução em ordem.
+ *
+ * Até ISSUE_WIDTH instruções emitidas esperam em ordem de programa pelo início da execução. A
+ * instrução mais antiga começa quando os operandos foram escritos (RAW), nenhuma instrução em
+ * execução escreve o mesmo destino (WAW), não há sw em voo para a posição de um lw e alguma unidade
+ * do seu tipo aceita; enquanto ela espera, as seguintes também esperam. As instruções podem terminar
+ * fora de ordem, e como os operandos são lidos no início não há WAR.
+ */
+class InOrderEngine final : public PipelineEngine
+{
+public:
+  InOrderEngine(TraceSource &trace, std::ostream &outputFile, OutputFormat format, const SchedulerConfig &config)
+      : PipelineEngine(ENGINE_NAMES[static_cast<int>(EngineKind::InOrder)], trace, outputFile, format, config),
+        latch(config.issueWidth), head(0), count(0) {}
+
+protected:
+  void start() override
+  {
+    while (count > 0)
+    {
+      const PipelineOp &op = latch[head];
+      if ((op.src[0] != NO_REGISTER && writer[op.src[0]]) || writer[op.src[1]])
+      {
+        stats.hazard(Hazard::Raw);
+        return;
+      }
+      if (op.dest != NO_REGISTER && writer[op.dest])
+      {
+        stats.hazard(Hazard::Waw);
+        return;
+      }
+      if (op.inst.op == OpCode::Lw && storer[op.word])
+      {
+        stats.hazard(Hazard::MemoryOrder);
+        return;
+      }
+      PipelineUnits &group = unitsOf(op.inst);
+      size_t position = findAvailable(group.pool);
+      if (position == group.pool.size())
+      {
+        stats.hazard(Hazard::Structural);
+        return;
+      }
+
+      if (op.dest != NO_REGISTER)
+      {
+        writer[op.dest] = op.seq + 1;
+      }
+      if (op.inst.op == OpCode::Sw)
+      {
+        storer[op.word] = op.seq + 1;
+      }
+      group.operation[position] = op;
+      group.pool.busy.set(position);
+      begin(group, position);
+      head = (head + 1) % latch.size();
+      count--;
+    }
+  }
+
+  void issue() override
+  {
+    while (count < latch.size() && fetch())
+    {
+      latch[(head + count) % latch.size()] = take();
+      count++;
+    }
+  }
+
+  bool canWrite(const PipelineOp &) const override
+  {
+    return true;
+  }
+
+private:
+  std::vector<PipelineOp> latch; // Instruções emitidas esperando o início da execução (fila circular)
+  size_t head;
+  size_t count;
+};
+
+/**
+ * @brief Cria o motor pedido; o Tomasulo é o mesmo simulador de makeSimulator.
+ *
+ * Os motores de referência gravam apenas o formato texto (uma linha por instrução, com os ciclos
+ * de emissão, início e fim da execução e escrita) ou nenhum.
+ */
+inline std::unique_ptr<Engine> makeEngine(EngineKind kind, TraceSource &trace, std::ostream &outputFile,
+                                          OutputFormat format, const SchedulerConfig &config)
+{
+  switch (kind)
+  {
+  case EngineKind::InOrder:
+    return std::make_unique<InOrderEngine>(trace, outputFile, format, config);
+  case EngineKind::Scoreboard:
+    return std::make_unique<ScoreboardEngine>(trace, outputFile, format, config);
+  default:
+    return makeSimulator(trace, outputFile, format, false, config);
+  }
+}
+
+// Resultado de um motor na comparação
+struct EngineResult
+{
+  EngineKind kind;
+  int cycles;
+  size_t instructions;
+  double ipc;
+  std::string error; // Erro da simulação (por exemplo, uma simulação travada), se houver
+};
+
+/**
+ * @brief Simula o programa em todos os motores, em paralelo, com a mesma configuração.
+ *
+ * O arquivo de instruções é decodificado uma vez e compartilhado, somente para leitura, entre as
+ * simulações, como na varredura de parâmetros.
+ *
+ * @return false se o arquivo de instruções não pôde ser lido ou uma simulação falhou.
+ */
+inline bool compareEngines(const std::string &tracePath, const SchedulerConfig &config, unsigned threads,
+                           std::vector<EngineResult> &results, std::string &error)
+{
+  Program program;
+  if (program.load(tracePath, config.registerQnt, error) != TraceStatus::Ok)
+  {
+    return false;
+  }
+
+  results.assign(ENGINE_QNT, EngineResult{});
+  {
+    WorkStealingPool pool(std::min<unsigned>(threads, ENGINE_QNT));
+    for (int i = 0; i < ENGINE_QNT; i++)
+    {
+      EngineResult &result = results[i];
+      result.kind = static_cast<EngineKind>(i);
+      pool.submit([&program, &result, &config]()
+                  {
+                    MemoryTrace trace(program.data(), program.size());
+                    std::ostream discard(nullptr);
+                    std::unique_ptr<Engine> engine = makeEngine(result.kind, trace, discard, OutputFormat::None, config);
+                    engine->run();
+                    result.error = trace.error;
+                    result.cycles = engine->totalCycles();
+                    result.instructions = engine->completedCount();
+                    result.ipc = engine->ipc(); });
+    }
+    pool.wait();
+  }
+  for (const EngineResult &result : results)
+  {
+    if (!result.error.empty())
+    {
+      error = std::string(ENGINE_NAMES[static_cast<int>(result.kind)]) + ": " + result.error;
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Escreve os ciclos, o IPC e o ganho (speedup) de cada motor sobre o pipeline em ordem.
+ *
+ * @param json Um objeto JSON por motor, um por linha, no lugar da tabela.
+ */
+inline void writeEngineComparison(std::ostream &out, const std::vector<EngineResult> &results, bool json)
+{
+  int baseline = results.front().cycles;
+  for (size_t i = 0; json && i < results.size(); i++)
+  {
+    const EngineResult &result = results[i];
+    out << "{\"motor\":\"" << ENGINE_NAMES[static_cast<int>(result.kind)] << "\",\"ciclos\":" << result.cycles
+        << ",\"instrucoes\":" << result.instructions << ",\"ipc\":" << result.ipc
+        << ",\"speedup\":" << (result.cycles > 0 ? static_cast<double>(baseline) / result.cycles : 0.0) << "}\n";
+  }
+  if (json)
+  {
+    return;
+  }
+
+  out << "> Comparação dos motores (speedup sobre " << ENGINE_NAMES[static_cast<int>(results.front().kind)] << ")\n"
+      << "Motor             Ciclos    Instruções       IPC   Speedup\n"
+      << std::fixed;
+  for (const EngineResult &result : results)
+  {
+    out << std::left << std::setw(12) << ENGINE_NAMES[static_cast<int>(result.kind)] << std::right << std::setw(12)
+        << result.cycles << std::setw(14) << result.instructions << std::setw(10) << std::setprecision(3)
+        << result.ipc << std::setw(9) << std::setprecision(2)
+        << (result.cycles > 0 ? static_cast<double>(baseline) / result.cycles : 0.0) << "x\n";
+  }
+  out << std::defaultfloat << std::setprecision(6);
+}
+
+#endif
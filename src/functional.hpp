@@ -0,0 +1,110 @@
+#ifndef TOMASULO_FUNCTIONAL_HPP
+#define TOMASULO_FUNCTIONAL_HPP
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "config.hpp"
+#include "instruction.hpp"
+#include "memory.hpp"
+#include "scheduler.hpp"
+
+/**
+ * @brief Execução funcional: aplica as instruções em ordem de programa, sem modelo de tempo.
+ *
+ * Mantém apenas os registradores arquiteturais, a memória de dados e as caches (que continuam sendo
+ * acessadas para chegarem aquecidas às amostras detalhadas). O estado final é o mesmo da simulação
+ * detalhada do mesmo programa.
+ */
+class FunctionalSimulator
+{
+public:
+  int registerQnt;         // Quantidade de registradores F (e R)
+  std::vector<int> value;  // Valor de cada registrador arquitetural
+  std::vector<int> data;   // Memória de dados
+  MemoryHierarchy memory;  // Caches, aquecidas pelos acessos de lw e sw
+  std::uint64_t executed;  // Instruções executadas
+
+  FunctionalSimulator(const SchedulerConfig &config = SchedulerConfig())
+      : registerQnt(config.registerQnt), value(config.archRegisterQnt(), INITIAL_REGISTER_VALUE),
+        data(MEMORY_WORDS, INITIAL_MEMORY_VALUE), memory(config), executed(0) {}
+
+  void step(const Instruction &inst)
+  {
+    switch (inst.op)
+    {
+    case OpCode::Lw:
+    {
+      int address = performOperation(OpCode::Add, inst.imm, value[inst.src2]);
+      value[inst.dest] = data[static_cast<size_t>(address) % data.size()];
+      memory.access(address);
+      break;
+    }
+    case OpCode::Sw:
+    {
+      int address = performOperation(OpCode::Add, inst.imm, value[inst.src2]);
+      data[static_cast<size_t>(address) % data.size()] = value[inst.dest];
+      memory.access(address);
+      break;
+    }
+    default:
+      value[inst.dest] = performOperation(inst.op, value[inst.src1], value[inst.src2]);
+    }
+    executed++;
+  }
+
+  // Executa até `count` instruções da fonte; retorna quantas foram executadas
+  std::uint64_t run(TraceSource &trace, std::uint64_t count)
+  {
+    Instruction inst;
+    std::uint64_t done = 0;
+    while (done < count && trace.next(inst))
+    {
+      step(inst);
+      done++;
+    }
+    return done;
+  }
+
+  // Copia o estado arquitetural para um Scheduler recém-criado, antes da simulação detalhada
+  template <typename Observer, typename Machine>
+  void copyTo(BasicScheduler<Observer, Machine> &scheduler) const
+  {
+    for (size_t i = 0; i < value.size(); i++)
+    {
+      scheduler.registers.value[i] = value[i];
+    }
+    scheduler.cacheMem = data;
+    scheduler.memory = memory;
+  }
+
+  // Recupera o estado arquitetural de um Scheduler que concluiu todas as instruções
+  template <typename Observer, typename Machine>
+  void copyFrom(const BasicScheduler<Observer, Machine> &scheduler)
+  {
+    for (size_t i = 0; i < value.size(); i++)
+    {
+      value[i] = scheduler.registers.value[scheduler.rat[i]];
+    }
+    data = scheduler.cacheMem;
+    memory = scheduler.memory;
+  }
+
+  // Escreve o valor final dos registradores e da memória de dados
+  void writeState(std::ostream &out) const
+  {
+    out << "> Registradores\n";
+    for (size_t i = 0; i < value.size(); i++)
+    {
+      out << registerName(static_cast<std::uint8_t>(i), registerQnt) << " " << value[i] << "\n";
+    }
+    out << "\n> Memória\n";
+    for (size_t i = 0; i < data.size(); i++)
+    {
+      out << i << " " << data[i] << "\n";
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,347 @@
+#ifndef TOMASULO_INSTRUCTION_HPP
+#define TOMASULO_INSTRUCTION_HPP
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <limits>
+
+#include "config.hpp"
+
+// Códigos das operações suportadas
+enum class OpCode : std::uint8_t
+{
+  Add,
+  Sub,
+  Mul,
+  Div,
+  Lw,
+  Sw
+};
+
+// Classes de unidades funcionais
+enum class UnitType : std::uint8_t
+{
+  Add,
+  Mul,
+  Sw
+};
+
+// Indica um operando que não é registrador (ex: deslocamento de lw/sw)
+const std::uint8_t NO_REGISTER = 0xFF;
+
+// Instrução decodificada uma única vez a partir da linha do arquivo
+struct Instruction
+{
+  OpCode op;          // Tipo da operação
+  std::uint8_t dest;  // Índice do registrador de destino
+  std::uint8_t src1;  // Índice do primeiro operando (NO_REGISTER em lw/sw)
+  std::uint8_t src2;  // Índice do segundo operando
+  std::int32_t imm;   // Deslocamento imediato de lw/sw
+};
+
+// Nome textual de cada operação, indexado por OpCode
+const char *const OP_NAMES[] = {"add", "sub", "mul", "div", "lw", "sw"};
+
+// Unidade funcional responsável por cada operação, indexado por OpCode
+const UnitType OP_UNIT[] = {UnitType::Add, UnitType::Add, UnitType::Mul, UnitType::Mul, UnitType::Sw, UnitType::Sw};
+
+inline bool isMemoryOp(OpCode op)
+{
+  return op == OpCode::Lw || op == OpCode::Sw;
+}
+
+// Executa a operação aritmética (lw e sw usam Add para calcular o endereço)
+inline int performOperation(OpCode op, int src1, int src2)
+{
+  switch (op)
+  {
+  case OpCode::Add:
+    return src1 + src2;
+  case OpCode::Sub:
+    return src1 - src2;
+  case OpCode::Mul:
+    return src1 * src2;
+  case OpCode::Div:
+    // Divisão por zero (ou que estoura o int) não é definida; o resultado simulado é zero
+    if (src2 == 0 || (src2 == -1 && src1 == std::numeric_limits<int>::min()))
+    {
+      return 0;
+    }
+    return src1 / src2;
+  default:
+    return 0;
+  }
+}
+
+// Nome do registrador a partir do índice (F0..F15, R0..R15 e em seguida os temporários T0, T1, ...)
+inline std::string registerName(std::uint8_t id, int registerQnt = REGISTER_QNT)
+{
+  if (id < registerQnt)
+  {
+    return "F" + std::to_string(id);
+  }
+  if (id < 2 * registerQnt)
+  {
+    return "R" + std::to_string(id - registerQnt);
+  }
+  return "T" + std::to_string(id - 2 * registerQnt);
+}
+
+// Escreve a instrução no formato original do arquivo de entrada
+inline void writeInstruction(std::ostream &out, const Instruction &inst, int registerQnt = REGISTER_QNT)
+{
+  out << OP_NAMES[static_cast<int>(inst.op)] << " " << registerName(inst.dest, registerQnt) << " ";
+  if (isMemoryOp(inst.op))
+  {
+    out << inst.imm;
+  }
+  else
+  {
+    out << registerName(inst.src1, registerQnt);
+  }
+  out << " " << registerName(inst.src2, registerQnt);
+}
+
+// Converte um nome de registrador ("F6", "R2") para seu índice
+inline bool parseRegister(std::string_view token, std::uint8_t &id, int registerQnt = REGISTER_QNT)
+{
+  if (token.size() < 2 || (token[0] != 'F' && token[0] != 'R'))
+  {
+    return false;
+  }
+  int index = 0;
+  for (size_t i = 1; i < token.size(); i++)
+  {
+    if (token[i] < '0' || token[i] > '9')
+    {
+      return false;
+    }
+    index = index * 10 + (token[i] - '0');
+    if (index >= registerQnt)
+    {
+      return false;
+    }
+  }
+  id = static_cast<std::uint8_t>(token[0] == 'F' ? index : registerQnt + index);
+  return true;
+}
+
+// Converte um deslocamento decimal com sinal opcional ("34", "-8", "+4") que caiba em 32 bits
+inline bool parseImmediate(std::string_view token, std::int32_t &value)
+{
+  size_t i = !token.empty() && (token[0] == '-' || token[0] == '+') ? 1 : 0;
+  if (i == token.size())
+  {
+    return false;
+  }
+  std::int64_t magnitude = 0;
+  for (; i < token.size(); i++)
+  {
+    if (token[i] < '0' || token[i] > '9')
+    {
+      return false;
+    }
+    magnitude = magnitude * 10 + (token[i] - '0');
+    if (magnitude > std::int64_t(std::numeric_limits<std::int32_t>::max()) + 1)
+    {
+      return false;
+    }
+  }
+  std::int64_t signedValue = token[0] == '-' ? -magnitude : magnitude;
+  if (signedValue > std::numeric_limits<std::int32_t>::max())
+  {
+    return false;
+  }
+  value = static_cast<std::int32_t>(signedValue);
+  return true;
+}
+
+// Separa o próximo campo da linha (delimitado por espaços ou tabulações) a partir de `position`
+inline std::string_view nextToken(std::string_view line, size_t &position)
+{
+  while (position < line.size() && (line[position] == ' ' || line[position] == '\t' || line[position] == '\r'))
+  {
+    position++;
+  }
+  size_t start = position;
+  while (position < line.size() && line[position] != ' ' && line[position] != '\t' && line[position] != '\r')
+  {
+    position++;
+  }
+  return line.substr(start, position - start);
+}
+
+/**
+ * @brief Decodifica uma linha do arquivo de entrada em uma instrução compacta.
+ *
+ * O formato é "op dest src1 src2"; em lw/sw o src1 é o deslocamento imediato. A linha não é
+ * copiada e nada é alocado quando ela é válida; campos a mais são um erro.
+ *
+ * @param line Linha lida do arquivo, sem o fim de linha.
+ * @param inst Instrução decodificada (saída).
+ * @param error Descrição do problema quando a linha é inválida (saída).
+ * @param registerQnt Quantidade de registradores F (e R) da máquina simulada.
+ * @return true se a linha foi decodificada com sucesso.
+ */
+inline bool decodeInstruction(std::string_view line, Instruction &inst, std::string &error,
+                              int registerQnt = REGISTER_QNT)
+{
+  size_t position = 0;
+  std::string_view op = nextToken(line, position);
+  std::string_view dest = nextToken(line, position);
+  std::string_view src1 = nextToken(line, position);
+  std::string_view src2 = nextToken(line, position);
+  if (src2.empty())
+  {
+    error = "instrução incompleta";
+    return false;
+  }
+  std::string_view extra = nextToken(line, position);
+  if (!extra.empty())
+  {
+    error = "campo a mais '" + std::string(extra) + "'";
+    return false;
+  }
+
+  int code = 0;
+  while (code < 6 && op != OP_NAMES[code])
+  {
+    code++;
+  }
+  if (code == 6)
+  {
+    error = "operação desconhecida '" + std::string(op) + "'";
+    return false;
+  }
+  inst.op = static_cast<OpCode>(code);
+  inst.imm = 0;
+  inst.src1 = NO_REGISTER;
+
+  if (!parseRegister(dest, inst.dest, registerQnt))
+  {
+    error = "registrador inválido '" + std::string(dest) + "'";
+    return false;
+  }
+  if (!parseRegister(src2, inst.src2, registerQnt))
+  {
+    error = "registrador inválido '" + std::string(src2) + "'";
+    return false;
+  }
+
+  if (isMemoryOp(inst.op))
+  {
+    if (!parseImmediate(src1, inst.imm))
+    {
+      error = "deslocamento inválido '" + std::string(src1) + "'";
+      return false;
+    }
+  }
+  else if (!parseRegister(src1, inst.src1, registerQnt))
+  {
+    error = "registrador inválido '" + std::string(src1) + "'";
+    return false;
+  }
+  return true;
+}
+
+// Fonte de instruções consumida pelo Scheduler, em ordem de programa
+class TraceSource
+{
+public:
+  std::string error; // Descrição do erro de leitura ou decodificação, se houver
+
+  virtual ~TraceSource() {}
+
+  // Obtém a próxima instrução; retorna false quando não há mais instruções
+  virtual bool next(Instruction &inst) = 0;
+
+  // Descarta as próximas `count` instruções; retorna quantas foram descartadas
+  virtual size_t skip(size_t count)
+  {
+    Instruction inst;
+    size_t skipped = 0;
+    while (skipped < count && next(inst))
+    {
+      skipped++;
+    }
+    return skipped;
+  }
+};
+
+// Leitura incremental do arquivo de instruções, uma linha por vez
+class TraceReader : public TraceSource
+{
+public:
+  std::istream &input; // Arquivo de instruções
+  int registerQnt;     // Quantidade de registradores F (e R) usada na decodificação
+  int lineNumber;      // Última linha lida
+  std::string line;    // Linha atual, reutilizada entre as leituras
+
+  TraceReader(std::istream &input, int registerQnt = REGISTER_QNT)
+      : input(input), registerQnt(registerQnt), lineNumber(0) {}
+
+  /**
+   * @brief Lê e decodifica a próxima instrução; linhas em branco são ignoradas.
+   *
+   * @param inst Instrução decodificada (saída).
+   * @return false no fim do arquivo ou em uma linha inválida (nesse caso error é preenchido).
+   */
+  bool next(Instruction &inst) override
+  {
+    while (error.empty() && std::getline(input, line))
+    {
+      lineNumber++;
+      if (line.find_first_not_of(" \t\r") == std::string::npos)
+      {
+        continue;
+      }
+
+      std::string reason;
+      if (!decodeInstruction(line, inst, reason, registerQnt))
+      {
+        error = "linha " + std::to_string(lineNumber) + ": " + reason;
+        return false;
+      }
+      return true;
+    }
+    return false;
+  }
+};
+
+// Instruções já decodificadas em memória, compartilhadas entre várias simulações
+class MemoryTrace : public TraceSource
+{
+public:
+  const Instruction *instructions; // Programa decodificado (somente leitura)
+  size_t count;                    // Quantidade de instruções
+  size_t position;                 // Próxima instrução a entregar
+
+  MemoryTrace(const Instruction *instructions, size_t count)
+      : instructions(instructions), count(count), position(0) {}
+
+  MemoryTrace(const std::vector<Instruction> &instructions)
+      : MemoryTrace(instructions.data(), instructions.size()) {}
+
+  bool next(Instruction &inst) override
+  {
+    if (position == count)
+    {
+      return false;
+    }
+    inst = instructions[position++];
+    return true;
+  }
+
+  size_t skip(size_t count) override
+  {
+    size_t skipped = std::min(count, this->count - position);
+    position += skipped;
+    return skipped;
+  }
+};
+
+#endif
@@ -0,0 +1,389 @@
+#ifndef TOMASULO_LZ4_HPP
+#define TOMASULO_LZ4_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+/**
+ * Compressão LZ4 sem dependências externas.
+ *
+ * Os blocos seguem o formato de bloco do LZ4 e o arquivo segue o formato de quadro (frame), então a
+ * saída comprimida pelo simulador pode ser lida com `lz4 -d` e arquivos gravados com `lz4` podem ser
+ * lidos pelo Lz4InputBuffer. O compressor é o guloso simples: uma tabela de hash das posições já
+ * vistas e nenhuma busca por casamentos melhores.
+ */
+const std::uint32_t LZ4_FRAME_MAGIC = 0x184D2204;
+const size_t LZ4_BLOCK_SIZE = 1 << 20;       // Tamanho máximo dos blocos gravados (BD = 6, 1 MiB)
+const size_t LZ4_MAX_BLOCK_SIZE = 4 << 20;   // Maior bloco permitido pelo formato (BD = 7)
+const size_t LZ4_WINDOW = 1 << 16;           // Distância máxima de um casamento
+
+inline std::uint32_t lz4Read32(const char *p)
+{
+  return static_cast<std::uint32_t>(static_cast<std::uint8_t>(p[0])) |
+         static_cast<std::uint32_t>(static_cast<std::uint8_t>(p[1])) << 8 |
+         static_cast<std::uint32_t>(static_cast<std::uint8_t>(p[2])) << 16 |
+         static_cast<std::uint32_t>(static_cast<std::uint8_t>(p[3])) << 24;
+}
+
+inline void lz4Put32(std::string &out, std::uint32_t value)
+{
+  for (int i = 0; i < 4; i++)
+  {
+    out.push_back(static_cast<char>(value >> (8 * i)));
+  }
+}
+
+// Hash xxHash32, usado no byte de verificação do cabeçalho do quadro
+inline std::uint32_t xxh32(const char *data, size_t size, std::uint32_t seed = 0)
+{
+  const std::uint32_t P1 = 2654435761U, P2 = 2246822519U, P3 = 3266489917U, P4 = 668265263U, P5 = 374761393U;
+  auto rotl = [](std::uint32_t x, int r)
+  { return (x << r) | (x >> (32 - r)); };
+  size_t pos = 0;
+  std::uint32_t hash;
+  if (size >= 16)
+  {
+    std::uint32_t v[4] = {seed + P1 + P2, seed + P2, seed, seed - P1};
+    for (; pos + 16 <= size; pos += 16)
+    {
+      for (int lane = 0; lane < 4; lane++)
+      {
+        v[lane] = rotl(v[lane] + lz4Read32(data + pos + 4 * lane) * P2, 13) * P1;
+      }
+    }
+    hash = rotl(v[0], 1) + rotl(v[1], 7) + rotl(v[2], 12) + rotl(v[3], 18);
+  }
+  else
+  {
+    hash = seed + P5;
+  }
+  hash += static_cast<std::uint32_t>(size);
+  for (; pos + 4 <= size; pos += 4)
+  {
+    hash = rotl(hash + lz4Read32(data + pos) * P3, 17) * P4;
+  }
+  for (; pos < size; pos++)
+  {
+    hash = rotl(hash + static_cast<std::uint8_t>(data[pos]) * P5, 11) * P1;
+  }
+  hash ^= hash >> 15;
+  hash *= P2;
+  hash ^= hash >> 13;
+  hash *= P3;
+  return hash ^ (hash >> 16);
+}
+
+// Compressor de blocos independentes; a tabela de hash é reaproveitada entre os blocos
+class Lz4Compressor
+{
+public:
+  Lz4Compressor()
+      : table(1 << HASH_LOG) {}
+
+  // Comprime `size` bytes e acrescenta o bloco em `out`
+  void compress(const char *src, size_t size, std::string &out)
+  {
+    std::fill(table.begin(), table.end(), 0);
+    size_t anchor = 0;
+    if (size > MF_LIMIT)
+    {
+      size_t matchLimit = size - LAST_LITERALS;
+      size_t ip = 0;
+      unsigned misses = 0;
+      while (ip + MF_LIMIT <= size)
+      {
+        std::uint32_t word = lz4Read32(src + ip);
+        std::uint32_t &entry = table[(word * 2654435761U) >> (32 - HASH_LOG)];
+        size_t ref = entry; // Posição + 1 (0: vazio)
+        entry = static_cast<std::uint32_t>(ip + 1);
+        if (ref == 0 || ip - (ref - 1) >= LZ4_WINDOW || lz4Read32(src + ref - 1) != word)
+        {
+          // Sem casamento: avança mais rápido em trechos que não comprimem
+          ip += 1 + (misses++ >> 6);
+          continue;
+        }
+        ref--;
+        size_t length = MIN_MATCH;
+        while (ip + length < matchLimit && src[ref + length] == src[ip + length])
+        {
+          length++;
+        }
+        sequence(out, src + anchor, ip - anchor, ip - ref, length);
+        ip += length;
+        anchor = ip;
+        misses = 0;
+      }
+    }
+    sequence(out, src + anchor, size - anchor, 0, 0);
+  }
+
+private:
+  static constexpr int HASH_LOG = 16;
+  static constexpr size_t MIN_MATCH = 4;
+  static constexpr size_t LAST_LITERALS = 5; // Os últimos bytes do bloco são sempre literais
+  static constexpr size_t MF_LIMIT = 12;     // Nenhum casamento começa nos últimos MF_LIMIT bytes
+
+  std::vector<std::uint32_t> table; // Última posição vista de cada hash de 4 bytes
+
+  static void putLength(std::string &out, size_t length)
+  {
+    for (; length >= 255; length -= 255)
+    {
+      out.push_back(static_cast<char>(255));
+    }
+    out.push_back(static_cast<char>(length));
+  }
+
+  // Literais seguidos de um casamento; `length` 0 encerra o bloco só com os literais
+  static void sequence(std::string &out, const char *literals, size_t literalCount, size_t offset, size_t length)
+  {
+    size_t matchCode = length ? length - MIN_MATCH : 0;
+    out.push_back(static_cast<char>((literalCount < 15 ? literalCount : 15) << 4 | (matchCode < 15 ? matchCode : 15)));
+    if (literalCount >= 15)
+    {
+      putLength(out, literalCount - 15);
+    }
+    out.append(literals, literalCount);
+    if (length == 0)
+    {
+      return;
+    }
+    out.push_back(static_cast<char>(offset));
+    out.push_back(static_cast<char>(offset >> 8));
+    if (matchCode >= 15)
+    {
+      putLength(out, matchCode - 15);
+    }
+  }
+};
+
+/**
+ * @brief Descomprime um bloco para dst[start, capacity).
+ *
+ * Os casamentos podem apontar para os bytes anteriores a `start` (blocos encadeados).
+ *
+ * @return Bytes produzidos ou -1 se o bloco for inválido.
+ */
+inline std::int64_t lz4DecompressBlock(const char *src, size_t size, char *dst, size_t start, size_t capacity)
+{
+  size_t ip = 0;
+  size_t op = start;
+  auto readLength = [&](size_t &length) -> bool
+  {
+    std::uint8_t byte;
+    do
+    {
+      if (ip >= size)
+      {
+        return false;
+      }
+      byte = static_cast<std::uint8_t>(src[ip++]);
+      length += byte;
+    } while (byte == 255);
+    return true;
+  };
+  while (ip < size)
+  {
+    std::uint8_t token = static_cast<std::uint8_t>(src[ip++]);
+    size_t literals = token >> 4;
+    if ((literals == 15 && !readLength(literals)) || literals > size - ip || literals > capacity - op)
+    {
+      return -1;
+    }
+    std::memcpy(dst + op, src + ip, literals);
+    ip += literals;
+    op += literals;
+    if (ip == size)
+    {
+      break;
+    }
+
+    if (size - ip < 2)
+    {
+      return -1;
+    }
+    size_t offset = static_cast<std::uint8_t>(src[ip]) | static_cast<size_t>(static_cast<std::uint8_t>(src[ip + 1])) << 8;
+    ip += 2;
+    size_t length = token & 15;
+    if (offset == 0 || offset > op || (length == 15 && !readLength(length)) || length + 4 > capacity - op)
+    {
+      return -1;
+    }
+    // Cópia byte a byte: o casamento pode se sobrepor ao que está sendo escrito
+    for (size_t end = op + length + 4; op < end; op++)
+    {
+      dst[op] = dst[op - offset];
+    }
+  }
+  return static_cast<std::int64_t>(op - start);
+}
+
+/**
+ * @brief Grava um quadro LZ4: cabeçalho, blocos independentes de até LZ4_BLOCK_SIZE e o marcador final.
+ *
+ * Blocos que não diminuem são gravados sem compressão, como o formato permite.
+ */
+class Lz4FrameWriter
+{
+public:
+  // Cabeçalho do quadro: versão 1, blocos independentes, sem checksums nem tamanho do conteúdo
+  void begin(std::string &out)
+  {
+    lz4Put32(out, LZ4_FRAME_MAGIC);
+    const char descriptor[2] = {0x60, 0x60};
+    out.append(descriptor, 2);
+    out.push_back(static_cast<char>(xxh32(descriptor, 2) >> 8));
+  }
+
+  void block(const char *data, size_t size, std::string &out)
+  {
+    size_t header = out.size();
+    lz4Put32(out, 0);
+    compressor.compress(data, size, out);
+    size_t compressed = out.size() - header - 4;
+    if (compressed >= size)
+    {
+      out.resize(header);
+      lz4Put32(out, static_cast<std::uint32_t>(size) | 0x80000000U);
+      out.append(data, size);
+      return;
+    }
+    for (int i = 0; i < 4; i++)
+    {
+      out[header + i] = static_cast<char>(compressed >> (8 * i));
+    }
+  }
+
+  void end(std::string &out)
+  {
+    lz4Put32(out, 0);
+  }
+
+private:
+  Lz4Compressor compressor;
+};
+
+/**
+ * @brief Leitura de um quadro LZ4 como um fluxo de bytes, um bloco por vez.
+ *
+ * Aceita blocos independentes ou encadeados, de qualquer tamanho do formato; os checksums
+ * opcionais são ignorados. O identificador do quadro já deve ter sido lido da entrada.
+ */
+class Lz4InputBuffer : public std::streambuf
+{
+public:
+  std::string error; // Preenchido se o quadro for inválido
+
+  Lz4InputBuffer(std::istream &in)
+      : in(in), blockChecksum(false), linked(false), maxBlock(0), history(0), ended(false)
+  {
+    char descriptor[2];
+    if (!in.read(descriptor, 2))
+    {
+      fail();
+      return;
+    }
+    std::uint8_t flags = static_cast<std::uint8_t>(descriptor[0]);
+    int sizeCode = (static_cast<std::uint8_t>(descriptor[1]) >> 4) & 7;
+    if ((flags >> 6) != 1 || sizeCode < 4)
+    {
+      fail();
+      return;
+    }
+    linked = !(flags & 0x20);
+    blockChecksum = flags & 0x10;
+    maxBlock = size_t(1) << (2 * sizeCode + 8);
+    size_t skip = 1 + (flags & 0x08 ? 8 : 0) + (flags & 0x01 ? 4 : 0); // Checksum, tamanho e dicionário
+    in.ignore(static_cast<std::streamsize>(skip));
+    buffer.resize(LZ4_WINDOW + maxBlock);
+  }
+
+protected:
+  int_type underflow() override
+  {
+    if (gptr() < egptr())
+    {
+      return traits_type::to_int_type(*gptr());
+    }
+    while (!ended && error.empty())
+    {
+      char header[4];
+      if (!in.read(header, 4))
+      {
+        fail();
+        break;
+      }
+      std::uint32_t size = lz4Read32(header);
+      if (size == 0)
+      {
+        ended = true;
+        break;
+      }
+      bool stored = size & 0x80000000U;
+      size &= 0x7FFFFFFFU;
+      if (size > maxBlock || size > LZ4_MAX_BLOCK_SIZE)
+      {
+        fail();
+        break;
+      }
+      block.resize(size);
+      if (!in.read(block.data(), size) || (blockChecksum && !in.ignore(4)))
+      {
+        fail();
+        break;
+      }
+
+      // Os blocos encadeados podem copiar dos últimos LZ4_WINDOW bytes do bloco anterior
+      keepHistory();
+      std::int64_t produced = size;
+      if (stored)
+      {
+        std::memcpy(buffer.data() + history, block.data(), size);
+      }
+      else
+      {
+        produced = lz4DecompressBlock(block.data(), size, buffer.data(), history, buffer.size());
+      }
+      if (produced < 0)
+      {
+        fail();
+        break;
+      }
+      if (produced > 0)
+      {
+        setg(buffer.data(), buffer.data() + history, buffer.data() + history + produced);
+        return traits_type::to_int_type(*gptr());
+      }
+    }
+    return traits_type::eof();
+  }
+
+private:
+  std::istream &in;
+  bool blockChecksum;        // Cada bloco é seguido de 4 bytes de checksum
+  bool linked;               // Blocos encadeados
+  size_t maxBlock;           // Tamanho máximo de bloco declarado no cabeçalho
+  size_t history;            // Bytes do bloco anterior mantidos no início de `buffer`
+  bool ended;                // Marcador final lido
+  std::vector<char> buffer;  // Histórico seguido do bloco descomprimido
+  std::vector<char> block;   // Bloco como está no arquivo
+
+  void keepHistory()
+  {
+    size_t produced = egptr() ? static_cast<size_t>(egptr() - buffer.data()) : 0;
+    history = linked ? std::min(produced, LZ4_WINDOW) : 0;
+    std::memmove(buffer.data(), buffer.data() + produced - history, history);
+  }
+
+  void fail()
+  {
+    error = "quadro LZ4 inválido ou truncado";
+  }
+};
+
+#endif
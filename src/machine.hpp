@@ -0,0 +1,136 @@
+#ifndef TOMASULO_MACHINE_HPP
+#define TOMASULO_MACHINE_HPP
+
+#include "config.hpp"
+#include "instruction.hpp"
+
+/**
+ * @brief Parâmetros usados no laço da simulação, lidos da configuração em tempo de execução.
+ *
+ * O BasicScheduler consulta a janela, as larguras de emissão, retirada e do barramento comum, a fila
+ * de loads e stores, as latências e os registradores por meio da máquina, que é um parâmetro do
+ * template. FixedMachine tem a mesma interface com valores constantes.
+ */
+class RuntimeMachine
+{
+public:
+  explicit RuntimeMachine(const SchedulerConfig &config)
+      : parameters(config) {}
+
+  const SchedulerConfig &config() const
+  {
+    return parameters;
+  }
+
+  size_t windowSize() const
+  {
+    return static_cast<size_t>(parameters.windowSize);
+  }
+
+  size_t cdbWidth() const
+  {
+    return static_cast<size_t>(parameters.cdbWidth);
+  }
+
+  size_t issueWidth() const
+  {
+    return static_cast<size_t>(parameters.issueWidth);
+  }
+
+  size_t commitWidth() const
+  {
+    return static_cast<size_t>(parameters.commitWidth);
+  }
+
+  size_t lsqSize() const
+  {
+    return static_cast<size_t>(parameters.lsqSize);
+  }
+
+  int archRegisterQnt() const
+  {
+    return parameters.archRegisterQnt();
+  }
+
+  int renameRegisterQnt() const
+  {
+    return parameters.renameRegisterQnt;
+  }
+
+  int latency(UnitType type) const
+  {
+    return type == UnitType::Add ? parameters.addUnitClock
+                                 : type == UnitType::Mul ? parameters.mulUnitClock : parameters.swUnitClock;
+  }
+
+private:
+  SchedulerConfig parameters;
+};
+
+/**
+ * @brief Parâmetros fixos em tempo de compilação.
+ *
+ * Todas as consultas são constantes, de modo que o compilador especializa o laço da simulação para
+ * a configuração: os índices da janela e da fila de loads e stores viram máscaras quando WINDOW_SIZE
+ * e LSQ_SIZE são potências de 2 e latências e larguras entram no código como imediatos. A
+ * configuração recebida no construtor é ignorada; o simulador usa sempre CONFIG.
+ */
+template <const SchedulerConfig &CONFIG>
+class FixedMachine
+{
+public:
+  explicit FixedMachine(const SchedulerConfig & = CONFIG) {}
+
+  static constexpr const SchedulerConfig &config()
+  {
+    return CONFIG;
+  }
+
+  static constexpr size_t windowSize()
+  {
+    return static_cast<size_t>(CONFIG.windowSize);
+  }
+
+  static constexpr size_t cdbWidth()
+  {
+    return static_cast<size_t>(CONFIG.cdbWidth);
+  }
+
+  static constexpr size_t issueWidth()
+  {
+    return static_cast<size_t>(CONFIG.issueWidth);
+  }
+
+  static constexpr size_t commitWidth()
+  {
+    return static_cast<size_t>(CONFIG.commitWidth);
+  }
+
+  static constexpr size_t lsqSize()
+  {
+    return static_cast<size_t>(CONFIG.lsqSize);
+  }
+
+  static constexpr int archRegisterQnt()
+  {
+    return CONFIG.archRegisterQnt();
+  }
+
+  static constexpr int renameRegisterQnt()
+  {
+    return CONFIG.renameRegisterQnt;
+  }
+
+  static constexpr int latency(UnitType type)
+  {
+    return type == UnitType::Add ? CONFIG.addUnitClock
+                                 : type == UnitType::Mul ? CONFIG.mulUnitClock : CONFIG.swUnitClock;
+  }
+};
+
+// Configuração de produção: as constantes de config.hpp
+inline constexpr SchedulerConfig PRODUCTION_CONFIG{};
+
+using ProductionMachine = FixedMachine<PRODUCTION_CONFIG>;
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef TOMASULO_MAPPED_FILE_HPP
+#define TOMASULO_MAPPED_FILE_HPP
+
+#include <string>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Arquivo regular mapeado em memória somente para leitura; um arquivo vazio não tem mapeamento
+class MappedFile
+{
+public:
+  const char *data = nullptr;
+  size_t size = 0;
+
+  bool open(const std::string &path, std::string &error)
+  {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+      error = "erro ao abrir '" + path + "'";
+      return false;
+    }
+    struct stat info;
+    bool regular = fstat(fd, &info) == 0 && S_ISREG(info.st_mode);
+    if (regular && info.st_size > 0)
+    {
+      void *mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mapped != MAP_FAILED)
+      {
+        data = static_cast<const char *>(mapped);
+        size = info.st_size;
+      }
+    }
+    ::close(fd);
+    if (!regular || (info.st_size > 0 && !data))
+    {
+      error = "erro ao mapear '" + path + "'";
+      return false;
+    }
+    return true;
+  }
+
+  MappedFile() {}
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  MappedFile(MappedFile &&other) noexcept
+      : data(std::exchange(other.data, nullptr)), size(std::exchange(other.size, 0)) {}
+
+  MappedFile &operator=(MappedFile &&other) noexcept
+  {
+    std::swap(data, other.data);
+    std::swap(size, other.size);
+    return *this;
+  }
+
+  ~MappedFile()
+  {
+    if (data)
+    {
+      munmap(const_cast<char *>(data), size);
+    }
+  }
+};
+
+#endif
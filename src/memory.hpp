@@ -0,0 +1,346 @@
+#ifndef TOMASULO_MEMORY_HPP
+#define TOMASULO_MEMORY_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "config.hpp"
+#include "state.hpp"
+
+/**
+ * @brief Cache associativa por conjunto, usada apenas para o tempo dos acessos.
+ *
+ * Guarda só as tags (sem dados) em um vetor compacto de conjuntos x vias, com a idade LRU de cada
+ * via em um byte: 0 é a mais recente. Os valores da memória continuam na memória de dados do
+ * simulador.
+ */
+class Cache
+{
+public:
+  std::uint64_t hits = 0;
+  std::uint64_t misses = 0;
+  std::vector<std::uint64_t> tags; // Linha guardada em cada via mais 1 (0: vazia)
+  std::vector<std::uint8_t> age;   // Idade LRU de cada via dentro do conjunto
+
+  // Cache com `sets` conjuntos (0 desativa a cache), `ways` vias e linhas de `lineSize` bytes
+  Cache(int sets, int ways, int lineSize)
+      : tags(static_cast<size_t>(sets) * ways, 0), age(tags.size()), sets(sets), ways(ways), lineShift(0)
+  {
+    while ((1 << lineShift) < lineSize)
+    {
+      lineShift++;
+    }
+    for (size_t i = 0; i < age.size(); i++)
+    {
+      age[i] = static_cast<std::uint8_t>(i % ways);
+    }
+  }
+
+  bool enabled() const
+  {
+    return sets > 0;
+  }
+
+  /**
+   * @brief Acessa o endereço, atualizando a ordem LRU do conjunto.
+   *
+   * @param address Endereço em bytes.
+   * @return true em um acerto; em uma falta a linha substitui a via menos recente do conjunto.
+   */
+  bool access(std::uint64_t address)
+  {
+    std::uint64_t line = address >> lineShift;
+    size_t base = static_cast<size_t>(line & (sets - 1)) * ways;
+    std::uint64_t tag = line + 1; // 0 indica via vazia
+
+    size_t victim = base;
+    for (size_t way = base; way < base + ways; way++)
+    {
+      if (tags[way] == tag)
+      {
+        touch(base, way);
+        hits++;
+        return true;
+      }
+      if (age[way] > age[victim])
+      {
+        victim = way;
+      }
+    }
+    tags[victim] = tag;
+    touch(base, victim);
+    misses++;
+    return false;
+  }
+
+  // Indica se o endereço está na cache, sem alterar a ordem LRU nem os contadores
+  bool contains(std::uint64_t address) const
+  {
+    std::uint64_t line = address >> lineShift;
+    size_t base = static_cast<size_t>(line & (sets - 1)) * ways;
+    return std::find(tags.begin() + base, tags.begin() + base + ways, line + 1) != tags.begin() + base + ways;
+  }
+
+private:
+  int sets;
+  int ways;
+  int lineShift; // log2 do tamanho da linha
+
+  // Torna a via a mais recente do conjunto
+  void touch(size_t base, size_t way)
+  {
+    for (size_t other = base; other < base + ways; other++)
+    {
+      if (age[other] < age[way])
+      {
+        age[other]++;
+      }
+    }
+    age[way] = 0;
+  }
+};
+
+// Hierarquia L1/L2 e memória principal
+class MemoryHierarchy
+{
+public:
+  Cache l1;
+  Cache l2;
+  int l2Latency;
+  int memLatency;
+
+  MemoryHierarchy(const SchedulerConfig &config)
+      : l1(config.l1Sets, config.l1Ways, config.l1Line), l2(config.l2Sets, config.l2Ways, config.l2Line),
+        l2Latency(config.l2Latency), memLatency(config.memLatency) {}
+
+  /**
+   * @brief Acessa uma palavra da memória.
+   *
+   * @param wordAddress Endereço da palavra (lw/sw), convertido para bytes com palavras de 4 bytes.
+   * @return Ciclos além do acerto na L1: 0 em um acerto na L1 ou sem cache, L2_LATENCY em um
+   * acerto na L2 e mais MEM_LATENCY em uma falta na última cache.
+   */
+  int access(std::int64_t wordAddress)
+  {
+    std::uint64_t address = static_cast<std::uint64_t>(wordAddress) * 4;
+    if (!l1.enabled() || l1.access(address))
+    {
+      return 0;
+    }
+    if (!l2.enabled())
+    {
+      return memLatency;
+    }
+    return l2.access(address) ? l2Latency : l2Latency + memLatency;
+  }
+};
+
+/**
+ * @brief Acesso de um núcleo à memória compartilhada durante um quantum.
+ *
+ * Enquanto os núcleos executam em paralelo a memória compartilhada é somente leitura: os stores
+ * retirados e as faltas na L1 ficam registrados na porta do núcleo e são aplicados por
+ * SharedMemory::commit() na barreira. O núcleo enxerga os próprios stores do quantum pela porta.
+ */
+class MemoryPort
+{
+public:
+  // Store retirado no quantum, ainda não visível aos outros núcleos
+  struct Store
+  {
+    int cycle;
+    size_t index;
+    int value;
+  };
+
+  // Falta na L1 enviada ao barramento compartilhado
+  struct Access
+  {
+    int cycle;
+    std::uint64_t address;
+  };
+
+  const std::vector<int> *data;            // Memória de dados comum
+  const Cache *l2;                         // L2 comum
+  int l2Latency;                           // Ciclos adicionais de um acerto na L2
+  int memLatency;                          // Ciclos adicionais de uma falta na L2
+  std::vector<Store> stores;               // Stores do quantum, em ordem de retirada
+  std::vector<Access> accesses;            // Faltas na L1 do quantum, em ordem
+  std::unordered_map<size_t, int> written; // Último valor escrito pelo núcleo em cada posição no quantum
+  int busyUntil;                           // Primeiro ciclo livre do barramento visto pelo núcleo
+  std::uint64_t busAccesses;               // Faltas na L1 enviadas ao barramento
+  std::uint64_t busWaitCycles;             // Ciclos esperando o barramento comum
+
+  MemoryPort(const std::vector<int> &data, const Cache &l2, int l2Latency, int memLatency)
+      : data(&data), l2(&l2), l2Latency(l2Latency), memLatency(memLatency), busyUntil(0), busAccesses(0),
+        busWaitCycles(0) {}
+
+  // Valor da posição como o núcleo a enxerga: o último store dele no quantum ou a memória comum
+  int load(size_t index) const
+  {
+    auto found = written.find(index);
+    return found != written.end() ? found->second : (*data)[index];
+  }
+
+  void store(int cycle, size_t index, int value)
+  {
+    stores.push_back(Store{cycle, index, value});
+    written[index] = value;
+  }
+
+  /**
+   * @brief Acessa uma palavra pela L1 do núcleo e, em uma falta, pelo barramento e pela L2 comuns.
+   *
+   * @return Ciclos além do acerto na L1, incluindo a espera pelo barramento.
+   */
+  int access(int cycle, std::int64_t wordAddress, Cache &l1)
+  {
+    std::uint64_t address = static_cast<std::uint64_t>(wordAddress) * 4;
+    if (!l1.enabled() || l1.access(address))
+    {
+      return 0;
+    }
+    int start = std::max(cycle, busyUntil);
+    int wait = start - cycle;
+    busyUntil = start + 1;
+    accesses.push_back(Access{cycle, address});
+    busAccesses++;
+    busWaitCycles += wait;
+    if (!l2->enabled())
+    {
+      return wait + memLatency;
+    }
+    return wait + (l2->contains(address) ? l2Latency : l2Latency + memLatency);
+  }
+};
+
+/**
+ * @brief Memória de dados, L2 e barramento compartilhados por vários núcleos.
+ *
+ * Cada núcleo tem a própria L1; as faltas na L1 usam um barramento comum, que atende um pedido por
+ * ciclo, e a L2 compartilhada. Durante um quantum cada núcleo vê a memória, a L2 e a ocupação do
+ * barramento como estavam no início dele, somadas às próprias operações. Na barreira, commit()
+ * aplica as operações de todos os núcleos na ordem (ciclo, núcleo, ordem de programa), de modo
+ * que o resultado não depende de quantas threads simulam os núcleos.
+ */
+class SharedMemory
+{
+public:
+  std::vector<int> data;         // Memória de dados comum (MEMORY_WORDS palavras)
+  Cache l2;                      // L2 compartilhada
+  int busyUntil;                 // Primeiro ciclo em que o barramento está livre
+  std::vector<MemoryPort> ports; // Uma porta por núcleo
+
+  SharedMemory(const SchedulerConfig &config, size_t cores)
+      : data(MEMORY_WORDS, INITIAL_MEMORY_VALUE), l2(config.l2Sets, config.l2Ways, config.l2Line), busyUntil(0),
+        ports(cores, MemoryPort(data, l2, config.l2Latency, config.memLatency)) {}
+
+  // As portas guardam ponteiros para a memória e a L2 desta instância
+  SharedMemory(const SharedMemory &) = delete;
+  SharedMemory &operator=(const SharedMemory &) = delete;
+
+  // Aplica as operações do quantum de todos os núcleos, na ordem (ciclo, núcleo)
+  void commit()
+  {
+    sortOperations(&MemoryPort::accesses);
+    for (const auto &entry : order)
+    {
+      const MemoryPort::Access &access = ports[std::get<1>(entry)].accesses[std::get<2>(entry)];
+      busyUntil = std::max(busyUntil, access.cycle) + 1;
+      if (l2.enabled())
+      {
+        l2.access(access.address);
+      }
+    }
+
+    sortOperations(&MemoryPort::stores);
+    for (const auto &entry : order)
+    {
+      const MemoryPort::Store &store = ports[std::get<1>(entry)].stores[std::get<2>(entry)];
+      data[store.index] = store.value;
+    }
+
+    for (MemoryPort &port : ports)
+    {
+      port.stores.clear();
+      port.accesses.clear();
+      port.written.clear();
+      port.busyUntil = busyUntil;
+    }
+  }
+
+private:
+  std::vector<std::tuple<int, size_t, size_t>> order; // Ciclo, núcleo e posição de cada operação
+
+  // Ordena as operações registradas nas portas por ciclo, núcleo e posição
+  template <typename T>
+  void sortOperations(std::vector<T> MemoryPort::*log)
+  {
+    order.clear();
+    for (size_t core = 0; core < ports.size(); core++)
+    {
+      const std::vector<T> &operations = ports[core].*log;
+      for (size_t i = 0; i < operations.size(); i++)
+      {
+        order.emplace_back(operations[i].cycle, core, i);
+      }
+    }
+    std::sort(order.begin(), order.end());
+  }
+};
+
+// Operação de memória na fila de loads e stores
+struct LsqEntry
+{
+  Operation *op;        // Instrução na janela
+  bool isStore;         // sw (true) ou lw (false)
+  bool addressKnown;    // Endereço já calculado
+  bool completed;       // sw: dado e endereço capturados na conclusão
+  bool forwarded;       // lw: valor encaminhado de um sw anterior
+  std::int64_t address; // Endereço da palavra (deslocamento + registrador base)
+  int value;            // sw: dado a ser escrito; lw: valor encaminhado
+};
+
+/**
+ * @brief Fila de loads e stores em ordem de programa (buffer circular).
+ *
+ * Cada operação de memória recebe um número de sequência de memória na emissão e sai da fila
+ * quando é retirada da janela; os stores só escrevem na memória nesse momento.
+ */
+class LoadStoreQueue
+{
+public:
+  size_t head;                   // Número de sequência da operação de memória mais antiga na fila
+  size_t tail;                   // Número de sequência da próxima operação de memória
+  std::vector<LsqEntry> entries; // Posições da fila, indexadas pelo número de sequência
+
+  LoadStoreQueue(int size)
+      : head(0), tail(0), entries(size) {}
+
+  bool full() const
+  {
+    return tail - head == entries.size();
+  }
+
+  LsqEntry &at(size_t memSeq)
+  {
+    return entries[memSeq % entries.size()];
+  }
+
+  // Adiciona uma operação ao fim da fila e retorna seu número de sequência de memória
+  size_t push(Operation *op, bool isStore)
+  {
+    entries[tail % entries.size()] = LsqEntry{op, isStore, false, false, false, 0, 0};
+    return tail++;
+  }
+
+  void pop()
+  {
+    head++;
+  }
+};
+
+#endif
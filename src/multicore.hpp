@@ -0,0 +1,190 @@
+#ifndef TOMASULO_MULTICORE_HPP
+#define TOMASULO_MULTICORE_HPP
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "batch.hpp"
+#include "config.hpp"
+#include "memory.hpp"
+#include "simulator.hpp"
+#include "thread_pool.hpp"
+#include "tracefile.hpp"
+
+// Núcleo da simulação multinúcleo: simulador, arquivo de instruções e arquivo de saída próprios
+struct Core
+{
+  std::unique_ptr<TraceSource> trace;
+  std::ofstream output;
+  std::unique_ptr<Simulator> simulator;
+  bool done = false; // Todas as instruções do núcleo foram retiradas
+};
+
+// Escreve o resumo de cada núcleo e da memória compartilhada
+inline void writeMulticoreSummary(std::ostream &out, const std::vector<BatchJob> &jobs,
+                                  const SharedMemory &shared)
+{
+  std::uint64_t accesses = 0;
+  std::uint64_t waitCycles = 0;
+  for (size_t i = 0; i < jobs.size(); i++)
+  {
+    const MemoryPort &port = shared.ports[i];
+    out << "Núcleo " << i << " (" << jobs[i].input << "): ";
+    if (!jobs[i].error.empty())
+    {
+      out << jobs[i].error << "\n";
+      continue;
+    }
+    out << jobs[i].cycles << " ciclos, " << jobs[i].instructions << " instruções, IPC " << jobs[i].ipc << ", "
+        << port.busAccesses << " acessos ao barramento, " << port.busWaitCycles << " ciclos de espera\n";
+    accesses += port.busAccesses;
+    waitCycles += port.busWaitCycles;
+  }
+  out << "Memória compartilhada: L2 " << shared.l2.hits << " acertos / " << shared.l2.misses << " faltas, "
+      << accesses << " acessos ao barramento, " << waitCycles << " ciclos de espera\n";
+}
+
+// Escreve os contadores de cada núcleo, um objeto JSON por linha, seguidos da memória compartilhada
+inline void writeMulticoreStatsJson(std::ostream &out, const std::vector<Core> &cores, const SharedMemory &shared)
+{
+  for (size_t i = 0; i < cores.size(); i++)
+  {
+    const MemoryPort &port = shared.ports[i];
+    std::ostringstream stats;
+    cores[i].simulator->writeStats(stats, true);
+    std::string object = stats.str();
+    object.erase(object.find_last_not_of('\n') + 1);
+    out << "{\"nucleo\":" << i << ",\"barramento\":{\"acessos\":" << port.busAccesses
+        << ",\"ciclos_espera\":" << port.busWaitCycles << "},\"estatisticas\":" << object << "}\n";
+  }
+  out << "{\"memoria_compartilhada\":{\"l2\":{\"acertos\":" << shared.l2.hits << ",\"faltas\":" << shared.l2.misses
+      << "}}}\n";
+}
+
+/**
+ * @brief Simula um núcleo por arquivo de instruções, com memória de dados, L2 e barramento comuns.
+ *
+ * Os núcleos avançam em paralelo em até `threads` threads, `quantum` ciclos por vez; na barreira
+ * entre dois quanta as operações de memória de todos eles são aplicadas em uma ordem fixa
+ * (SharedMemory::commit()), então os resultados são os mesmos para qualquer quantidade de threads.
+ * Com quantum 1 os núcleos enxergam os stores e a ocupação do barramento dos outros a cada ciclo;
+ * quanta maiores sincronizam menos e escalam melhor com as threads, mas os núcleos só enxergam as
+ * operações dos outros no quantum seguinte.
+ *
+ * @param stats Formato das estatísticas de cada núcleo ("resumo", "json" ou vazio para nenhuma).
+ * @return Quantidade de núcleos com erro.
+ */
+inline size_t runMulticore(std::vector<BatchJob> &jobs, OutputFormat format, bool eventDriven,
+                           const SchedulerConfig &config, unsigned threads, int quantum, const std::string &stats,
+                           std::ostream &summary)
+{
+  for (const auto &job : jobs)
+  {
+    if (!job.error.empty())
+    {
+      summary << job.input << ": " << job.error << "\n";
+      return 1;
+    }
+  }
+
+  SharedMemory shared(config, jobs.size());
+  std::vector<Core> cores(jobs.size());
+  for (size_t i = 0; i < jobs.size(); i++)
+  {
+    Core &core = cores[i];
+    core.trace = openTrace(jobs[i].input, config.registerQnt, jobs[i].error);
+    if (core.trace)
+    {
+      core.output.open(jobs[i].output, std::ios::binary);
+      if (!core.output.is_open())
+      {
+        jobs[i].error = "erro ao abrir o arquivo de saída";
+      }
+    }
+    if (!jobs[i].error.empty())
+    {
+      summary << jobs[i].input << ": " << jobs[i].error << "\n";
+      return 1;
+    }
+    core.simulator = makeSimulator(*core.trace, core.output, format, eventDriven, config);
+    core.simulator->shareMemory(shared.ports[i]);
+  }
+
+  // Cada thread simula sempre os mesmos núcleos; a thread 0 aplica as operações na barreira
+  size_t threadCount = std::max<size_t>(1, std::min<size_t>(threads, cores.size()));
+  Barrier barrier(threadCount);
+  int lastCycle = 0;
+  bool finished = cores.empty();
+  auto worker = [&](size_t self)
+  {
+    while (!finished)
+    {
+      for (size_t i = self; i < cores.size(); i += threadCount)
+      {
+        if (!cores[i].done)
+        {
+          cores[i].done = cores[i].simulator->runUntil(lastCycle + quantum);
+        }
+      }
+      barrier.wait();
+      if (self == 0)
+      {
+        shared.commit();
+        lastCycle += quantum;
+        finished = std::all_of(cores.begin(), cores.end(), [](const Core &core)
+                               { return core.done; });
+      }
+      barrier.wait();
+    }
+  };
+  std::vector<std::thread> workers;
+  for (size_t t = 1; t < threadCount; t++)
+  {
+    workers.emplace_back(worker, t);
+  }
+  worker(0);
+  for (auto &thread : workers)
+  {
+    thread.join();
+  }
+
+  size_t failed = 0;
+  for (size_t i = 0; i < cores.size(); i++)
+  {
+    Core &core = cores[i];
+    core.simulator->finish();
+    jobs[i].error = core.trace->error;
+    jobs[i].cycles = core.simulator->totalCycles();
+    jobs[i].instructions = core.simulator->completedCount();
+    jobs[i].ipc = core.simulator->ipc();
+    failed += !jobs[i].error.empty();
+  }
+
+  if (stats == "json")
+  {
+    for (size_t i = 0; i < jobs.size(); i++)
+    {
+      if (!jobs[i].error.empty())
+      {
+        std::cerr << "Erro no núcleo " << i << " (" << jobs[i].input << "): " << jobs[i].error << std::endl;
+      }
+    }
+    writeMulticoreStatsJson(summary, cores, shared);
+    return failed;
+  }
+  writeMulticoreSummary(summary, jobs, shared);
+  for (size_t i = 0; stats == "resumo" && i < cores.size(); i++)
+  {
+    summary << "\n>> Núcleo " << i << "\n";
+    cores[i].simulator->writeStats(summary, false);
+  }
+  return failed;
+}
+
+#endif
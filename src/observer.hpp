@@ -0,0 +1,32 @@
+#ifndef TOMASULO_OBSERVER_HPP
+#define TOMASULO_OBSERVER_HPP
+
+#include <cstdint>
+
+#include "state.hpp"
+
+/**
+ * @brief Observador que ignora todos os eventos da simulação.
+ *
+ * Um observador é qualquer tipo com os mesmos métodos, passado como parâmetro do template
+ * BasicScheduler. As chamadas são resolvidas em tempo de compilação, então métodos vazios, como os
+ * deste, não deixam nenhum custo no laço da simulação.
+ *
+ * Eventos, na ordem em que acontecem para cada instrução:
+ *   issue          instrução emitida para uma estação de reserva
+ *   dispatch       instrução despachada para uma unidade funcional (tipo e posição em UnitPool)
+ *   complete       fim da execução na unidade (o resultado espera o CDB)
+ *   writeback      resultado difundido no CDB e instrução concluída
+ *   registerWrite  valor escrito em um registrador físico (também quando um valor renomeado volta
+ *                  ao registrador de origem)
+ */
+struct NullObserver
+{
+  void issue(int, const Operation &) {}
+  void dispatch(int, const Operation &, UnitType, size_t) {}
+  void complete(int, const Operation &) {}
+  void writeback(int, const Operation &) {}
+  void registerWrite(int, std::uint8_t, int) {}
+};
+
+#endif
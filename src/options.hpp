@@ -0,0 +1,218 @@
+#ifndef TOMASULO_OPTIONS_HPP
+#define TOMASULO_OPTIONS_HPP
+
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "config.hpp"
+#include "engines.hpp"
+#include "smt.hpp"
+#include "sweep.hpp"
+#include "thread_pool.hpp"
+
+// Opções da linha de comando; os pedidos do servidor usam as mesmas opções
+struct CommandLineOptions
+{
+  bool eventDriven = false;
+  bool batch = false;
+  bool multicore = false;
+  int quantum = 1; // Ciclos entre as barreiras da simulação multinúcleo
+  bool smt = false;
+  FetchPolicy fetchPolicy = FetchPolicy::RoundRobin;
+  bool policyGiven = false;
+  std::string statsFormat; // Vazio: sem estatísticas
+  std::string formatName;
+  SchedulerConfig config;
+  std::vector<SweepRange> ranges;
+  unsigned threads = defaultThreadCount();
+  std::vector<std::string> files;
+  std::vector<std::pair<int, std::string>> saves; // Checkpoints pedidos: ciclo e arquivo
+  std::string restorePath;
+  int stopCycle = std::numeric_limits<int>::max() - 1; // Último ciclo simulado (--ate)
+  bool stopGiven = false;
+  bool configGiven = false;
+  bool functionalOnly = false;
+  std::string samplingSpec; // Vazio: sem amostragem
+  bool explicitSamples = false;
+  bool preDecode = false;
+  bool compress = false;         // Saída da simulação detalhada comprimida em LZ4 (--comprimir)
+  bool dataflow = false;         // Análise de fluxo de dados (--fluxo-de-dados)
+  bool dataflowSimulate = false; // Compara a análise com uma simulação detalhada
+  EngineKind engine = EngineKind::Tomasulo; // Motor da simulação detalhada (--motor)
+  bool engineGiven = false;
+  bool compare = false;          // Compara os ciclos de todos os motores (--comparar)
+  bool server = false;           // Atende pedidos de simulação (--servidor)
+  std::string socketPath;        // Socket Unix do servidor; vazio: entrada e saída padrão
+  std::string serverOutputDir;   // Diretório onde os pedidos do servidor podem gravar (--saidas)
+};
+
+/**
+ * @brief Interpreta um argumento: uma opção, que começa com "--", ou um arquivo.
+ *
+ * Apenas o formato de cada opção é conferido aqui; as combinações válidas dependem do modo e são
+ * conferidas por quem usa as opções.
+ *
+ * @param error Mensagem para o usuário quando o argumento é inválido (saída).
+ * @return false se o argumento for inválido.
+ */
+inline bool parseCommandLineOption(const std::string &arg, CommandLineOptions &options, std::string &error)
+{
+  if (arg == "--eventos")
+  {
+    options.eventDriven = true;
+  }
+  else if (arg == "--lote")
+  {
+    options.batch = true;
+  }
+  else if (arg == "--nucleos")
+  {
+    options.multicore = true;
+  }
+  else if (arg == "--smt")
+  {
+    options.smt = true;
+  }
+  else if (arg.rfind("--politica=", 0) == 0)
+  {
+    options.policyGiven = true;
+    if (!parseFetchPolicy(arg.substr(11), options.fetchPolicy))
+    {
+      error = "Política inválida (use rodizio ou icount): " + arg;
+      return false;
+    }
+  }
+  else if (arg.rfind("--quantum=", 0) == 0)
+  {
+    if (!parseInt(arg.substr(10), options.quantum) || options.quantum < 1)
+    {
+      error = "Quantum inválido: " + arg;
+      return false;
+    }
+  }
+  else if (arg == "--estatisticas" || arg == "--estatisticas=resumo" || arg == "--estatisticas=json")
+  {
+    options.statsFormat = arg == "--estatisticas=json" ? "json" : "resumo";
+  }
+  else if (arg.rfind("--formato=", 0) == 0)
+  {
+    options.formatName = arg.substr(10);
+  }
+  else if (arg.rfind("--config=", 0) == 0)
+  {
+    if (!parseConfigAssignment(arg.substr(9), options.config, error))
+    {
+      error = "Configuração inválida: " + error;
+      return false;
+    }
+    options.configGiven = true;
+  }
+  else if (arg.rfind("--salvar=", 0) == 0)
+  {
+    size_t colon = arg.find(':', 9);
+    int saveCycle;
+    if (colon == std::string::npos || !parseInt(arg.substr(9, colon - 9), saveCycle) || saveCycle < 0 ||
+        colon + 1 == arg.size())
+    {
+      error = "Checkpoint inválido (use --salvar=CICLO:arquivo): " + arg;
+      return false;
+    }
+    options.saves.emplace_back(saveCycle, arg.substr(colon + 1));
+  }
+  else if (arg.rfind("--ate=", 0) == 0)
+  {
+    if (!parseInt(arg.substr(6), options.stopCycle) || options.stopCycle < 0)
+    {
+      error = "Ciclo inválido: " + arg;
+      return false;
+    }
+    options.stopGiven = true;
+  }
+  else if (arg.rfind("--restaurar=", 0) == 0)
+  {
+    options.restorePath = arg.substr(12);
+  }
+  else if (arg == "--pre-decodificar")
+  {
+    options.preDecode = true;
+  }
+  else if (arg == "--comprimir")
+  {
+    options.compress = true;
+  }
+  else if (arg == "--fluxo-de-dados" || arg == "--fluxo-de-dados=simular")
+  {
+    options.dataflow = true;
+    options.dataflowSimulate = arg == "--fluxo-de-dados=simular";
+  }
+  else if (arg.rfind("--motor=", 0) == 0)
+  {
+    options.engineGiven = true;
+    if (!parseEngineKind(arg.substr(8), options.engine))
+    {
+      error = "Motor inválido (use tomasulo, placar ou em-ordem): " + arg;
+      return false;
+    }
+  }
+  else if (arg == "--comparar")
+  {
+    options.compare = true;
+  }
+  else if (arg == "--servidor" || arg.rfind("--servidor=", 0) == 0)
+  {
+    options.server = true;
+    options.socketPath = arg == "--servidor" ? "" : arg.substr(11);
+  }
+  else if (arg.rfind("--saidas=", 0) == 0)
+  {
+    options.serverOutputDir = arg.substr(9);
+    if (options.serverOutputDir.empty())
+    {
+      error = "Diretório de saída inválido: " + arg;
+      return false;
+    }
+  }
+  else if (arg == "--funcional")
+  {
+    options.functionalOnly = true;
+  }
+  else if (arg.rfind("--amostragem=", 0) == 0 || arg.rfind("--amostras=", 0) == 0)
+  {
+    options.explicitSamples = arg.rfind("--amostras=", 0) == 0;
+    options.samplingSpec = arg.substr(arg.find('=') + 1);
+  }
+  else if (arg.rfind("--varrer=", 0) == 0)
+  {
+    SweepRange range;
+    if (!parseSweepRange(arg.substr(9), range, error))
+    {
+      error = "Configuração inválida: " + error;
+      return false;
+    }
+    options.ranges.push_back(range);
+  }
+  else if (arg.rfind("--threads=", 0) == 0)
+  {
+    int value;
+    if (!parseInt(arg.substr(10), value) || value < 1)
+    {
+      error = "Quantidade de threads inválida: " + arg;
+      return false;
+    }
+    options.threads = value;
+  }
+  else if (arg.rfind("--", 0) == 0)
+  {
+    error = "Opção desconhecida: " + arg;
+    return false;
+  }
+  else
+  {
+    options.files.push_back(arg);
+  }
+  return true;
+}
+
+#endif
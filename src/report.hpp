@@ -0,0 +1,552 @@
+#ifndef TOMASULO_REPORT_HPP
+#define TOMASULO_REPORT_HPP
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <iomanip>
+#include <cstdint>
+
+#include "state.hpp"
+
+// Formatos do arquivo de saída
+enum class OutputFormat : std::uint8_t
+{
+  Text,  // Relatório legível com o estado completo a cada ciclo
+  Delta, // Binário compacto com apenas as mudanças de estado
+  None   // Nenhum registro por ciclo (apenas o resultado final interessa)
+};
+
+// Texto como string JSON, com aspas, barras e caracteres de controle escapados
+inline std::string jsonString(const std::string &text)
+{
+  std::ostringstream out;
+  out << '"';
+  for (unsigned char c : text)
+  {
+    if (c == '"' || c == '\\')
+    {
+      out << '\\' << c;
+    }
+    else if (c < 0x20)
+    {
+      out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+    }
+    else
+    {
+      out << c;
+    }
+  }
+  out << '"';
+  return out.str();
+}
+
+// Texto como campo CSV entre aspas, com as aspas internas duplicadas
+inline std::string csvString(const std::string &text)
+{
+  std::string field = "\"";
+  for (char c : text)
+  {
+    field += c;
+    if (c == '"')
+    {
+      field += '"';
+    }
+  }
+  return field + "\"";
+}
+
+/**
+ * @brief Escreve o estado de um ciclo no formato de relatório legível.
+ *
+ * @param out Destino do relatório.
+ * @param cycle Ciclo atual.
+ * @param window Janela circular de instruções.
+ * @param first Número de sequência da primeira instrução ainda guardada na janela.
+ * @param end Número de sequência da próxima instrução a ser emitida.
+ * @param registers Registradores físicos.
+ * @param registerQnt Quantidade de registradores F (e R), usada nos nomes dos operandos.
+ */
+inline void writeStateReport(std::ostream &out, int cycle, const std::vector<Operation> &window,
+                             size_t first, size_t end, const RegisterFile &registers,
+                             int registerQnt = REGISTER_QNT)
+{
+  // Start of clock cycle state log
+  out << "\n------------\nCiclo " << cycle;
+
+  // Log issued instructions
+  out << "\n> Lidas: ";
+  for (size_t seq = first; seq < end; seq++)
+  {
+    if (window[seq % window.size()].isIssued)
+    {
+      out << "\n ";
+      writeInstruction(out, window[seq % window.size()].inst, registerQnt);
+    }
+  }
+
+  // Log executing instructions
+  out << "\n> Em execução:";
+  for (size_t seq = first; seq < end; seq++)
+  {
+    if (window[seq % window.size()].isExecuting)
+    {
+      out << "\n ";
+      writeInstruction(out, window[seq % window.size()].inst, registerQnt);
+    }
+  }
+
+  // Log completed instructions
+  out << "\n> Concluídas:";
+  for (size_t seq = first; seq < end; seq++)
+  {
+    if (window[seq % window.size()].isCompleted)
+    {
+      out << "\n ";
+      writeInstruction(out, window[seq % window.size()].inst, registerQnt);
+    }
+  }
+
+  // Integrated register status logging
+  out << "\n\n> Status dos Registradores:";
+  out << "\n"
+      << std::left
+      << std::setw(12) << "Registrador"
+      << std::setw(10) << "Valor"
+      << std::setw(15) << "(Leitura)"
+      << std::setw(15) << "(Escrita)"
+      << "Instrução Associada\n";
+  out << std::string(70, '-') << "\n";
+
+  // Iterate through registers and log their states
+  for (size_t i = 0; i < registers.size(); i++)
+  {
+    // Determine read and write status
+    std::string readStatus = registers.readers[i] > 0 ? "Ocupado" : "Livre";
+    std::string writeStatus = registers.isWriting(i) ? "Ocupado" : "Livre";
+
+    // Prepare instruction information
+    std::string instrInfo = "Nenhuma";
+    if (registers.instruction[i])
+    {
+      std::ostringstream info;
+      writeInstruction(info, registers.instruction[i]->inst, registerQnt);
+      instrInfo = info.str();
+    }
+
+    // Write register state to file
+    out << std::left
+        << std::setw(12) << registers.names[i]
+        << std::setw(10) << registers.value[i]
+        << std::setw(15) << readStatus
+        << std::setw(15) << writeStatus
+        << instrInfo << "\n";
+  }
+
+  // Additional separator for readability
+  out << std::string(70, '-') << "\n\n";
+}
+
+/*
+ * Formato delta (binário)
+ *
+ * Cabeçalho: "TDLT", versão (1 byte), REGISTER_QNT, RENAME_REGISTER_QNT, WINDOW_SIZE e primeiro
+ * ciclo do arquivo (varints; a versão 1 não tem o primeiro ciclo, que é sempre 1). Uma simulação
+ * restaurada de um checkpoint começa no ciclo seguinte ao checkpoint, com registros Issue para as
+ * instruções que já estavam na janela.
+ * Em seguida uma sequência de registros, cada um iniciado por um DeltaRecord:
+ *
+ *   Cycle     avanço do ciclo desde o último registro Cycle (varint); os registros seguintes
+ *             pertencem a esse ciclo. Ciclos sem mudanças não aparecem.
+ *   Issue     op, dest, src1, src2 (1 byte cada) e deslocamento (varint com zigzag)
+ *   Dispatch  distância da instrução até a próxima a ser emitida (varint); o mesmo vale para
+ *   ExecEnd   o fim da execução e
+ *   Complete  a conclusão
+ *   Register  índice (1 byte), flags (1 byte) e, conforme as flags, valor (zigzag) e
+ *             instrução associada (distância como acima, 0 para nenhuma)
+ *   End       último ciclo simulado (varint) e, a partir da versão 3, 1 se todas as instruções
+ *             foram concluídas ou 0 se a simulação parou antes (--ate); 1 byte
+ *
+ * Inteiros sem sinal usam LEB128; o estado inicial dos registradores é valor 0, livre e sem
+ * instrução, então o primeiro ciclo já traz os valores iniciais.
+ */
+const char DELTA_MAGIC[] = {'T', 'D', 'L', 'T'};
+const std::uint8_t DELTA_VERSION = 3;
+
+enum class DeltaRecord : std::uint8_t
+{
+  Cycle = 1,
+  Issue,
+  Dispatch,
+  ExecEnd,
+  Complete,
+  Register,
+  End
+};
+
+// Flags do registro Register
+const std::uint8_t DELTA_REG_READ = 0x01;
+const std::uint8_t DELTA_REG_WRITE = 0x02;
+const std::uint8_t DELTA_REG_VALUE = 0x04;
+const std::uint8_t DELTA_REG_INSTRUCTION = 0x08;
+
+// Escritor do formato delta; acumula os registros em memória e descarrega em blocos
+class DeltaWriter
+{
+public:
+  // Último estado de cada registrador já gravado no arquivo
+  struct RegisterShadow
+  {
+    int value;
+    std::uint8_t flags;
+    std::uint64_t instruction; // Número de sequência + 1 (0 para nenhuma)
+  };
+
+  std::ostream &out;                   // Arquivo de saída
+  std::string buffer;                  // Registros ainda não descarregados
+  int lastCycle;                       // Ciclo do último registro Cycle
+  std::uint64_t issued;                // Instruções emitidas até agora
+  std::vector<RegisterShadow> shadow;  // Estado dos registradores conhecido pelo leitor
+
+  DeltaWriter(std::ostream &out)
+      : out(out), lastCycle(0), issued(0) {}
+
+  ~DeltaWriter()
+  {
+    flush();
+  }
+
+  // Escreve o cabeçalho do arquivo
+  void begin(int registerQnt, int renameRegisterQnt, size_t windowSize, int firstCycle = 1)
+  {
+    buffer.append(DELTA_MAGIC, sizeof(DELTA_MAGIC));
+    buffer.push_back(static_cast<char>(DELTA_VERSION));
+    putVarint(registerQnt);
+    putVarint(renameRegisterQnt);
+    putVarint(windowSize);
+    putVarint(firstCycle);
+    lastCycle = firstCycle - 1;
+    shadow.assign(2 * registerQnt + renameRegisterQnt, RegisterShadow{0, 0, 0});
+  }
+
+  void issue(int cycle, const Instruction &inst)
+  {
+    mark(cycle, DeltaRecord::Issue);
+    buffer.push_back(static_cast<char>(inst.op));
+    buffer.push_back(static_cast<char>(inst.dest));
+    buffer.push_back(static_cast<char>(inst.src1));
+    buffer.push_back(static_cast<char>(inst.src2));
+    putSigned(inst.imm);
+    issued++;
+  }
+
+  void dispatch(int cycle, std::uint64_t seq)
+  {
+    mark(cycle, DeltaRecord::Dispatch);
+    putVarint(issued - seq);
+  }
+
+  void execEnd(int cycle, std::uint64_t seq)
+  {
+    mark(cycle, DeltaRecord::ExecEnd);
+    putVarint(issued - seq);
+  }
+
+  void complete(int cycle, std::uint64_t seq)
+  {
+    mark(cycle, DeltaRecord::Complete);
+    putVarint(issued - seq);
+  }
+
+  // Grava apenas os registradores que mudaram desde o último ciclo
+  void registers(int cycle, const RegisterFile &regs)
+  {
+    for (size_t i = 0; i < regs.size(); i++)
+    {
+      RegisterShadow &known = shadow[i];
+      int value = regs.value[i];
+      std::uint8_t flags = (regs.readers[i] > 0 ? DELTA_REG_READ : 0) | (regs.isWriting(i) ? DELTA_REG_WRITE : 0);
+      std::uint64_t instruction = regs.instruction[i] ? regs.instruction[i]->seq + 1 : 0;
+
+      std::uint8_t changes = flags;
+      if (value != known.value)
+      {
+        changes |= DELTA_REG_VALUE;
+      }
+      if (instruction != known.instruction)
+      {
+        changes |= DELTA_REG_INSTRUCTION;
+      }
+      if (changes == known.flags)
+      {
+        continue;
+      }
+
+      mark(cycle, DeltaRecord::Register);
+      buffer.push_back(static_cast<char>(i));
+      buffer.push_back(static_cast<char>(changes));
+      if (changes & DELTA_REG_VALUE)
+      {
+        putSigned(value);
+      }
+      if (changes & DELTA_REG_INSTRUCTION)
+      {
+        putVarint(instruction ? issued - (instruction - 1) : 0);
+      }
+      known = RegisterShadow{value, flags, instruction};
+    }
+    if (buffer.size() >= (1 << 16))
+    {
+      flush();
+    }
+  }
+
+  // Grava o fim da simulação; `complete` indica se todas as instruções foram concluídas
+  void finish(int finalCycle, bool complete)
+  {
+    buffer.push_back(static_cast<char>(DeltaRecord::End));
+    putVarint(finalCycle);
+    buffer.push_back(static_cast<char>(complete ? 1 : 0));
+    flush();
+  }
+
+  void flush()
+  {
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    buffer.clear();
+  }
+
+private:
+  // Abre um novo ciclo se necessário e escreve o tipo do registro
+  void mark(int cycle, DeltaRecord record)
+  {
+    if (cycle != lastCycle)
+    {
+      buffer.push_back(static_cast<char>(DeltaRecord::Cycle));
+      putVarint(cycle - lastCycle);
+      lastCycle = cycle;
+    }
+    buffer.push_back(static_cast<char>(record));
+  }
+
+  void putVarint(std::uint64_t value)
+  {
+    while (value >= 0x80)
+    {
+      buffer.push_back(static_cast<char>((value & 0x7F) | 0x80));
+      value >>= 7;
+    }
+    buffer.push_back(static_cast<char>(value));
+  }
+
+  void putSigned(std::int64_t value)
+  {
+    putVarint((static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63));
+  }
+};
+
+/**
+ * @brief Reconstrói o relatório legível a partir de um arquivo no formato delta.
+ *
+ * Mantém uma cópia da janela de instruções e dos registradores, aplica os registros de cada ciclo
+ * e escreve o estado de todos os ciclos, inclusive os que não tiveram mudanças. O resultado é
+ * idêntico ao gerado pelo simulador com o formato texto.
+ *
+ * @param in Arquivo delta.
+ * @param out Destino do relatório.
+ * @param error Descrição do problema quando o arquivo é inválido (saída).
+ * @return true se o arquivo foi decodificado por completo.
+ */
+inline bool decodeDelta(std::istream &in, std::ostream &out, std::string &error)
+{
+  auto getByte = [&in](std::uint8_t &byte) -> bool
+  {
+    int c = in.get();
+    byte = static_cast<std::uint8_t>(c);
+    return c != std::char_traits<char>::eof();
+  };
+  auto getVarint = [&getByte](std::uint64_t &value) -> bool
+  {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+      std::uint8_t byte;
+      if (!getByte(byte))
+      {
+        return false;
+      }
+      value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+      if (!(byte & 0x80))
+      {
+        return true;
+      }
+    }
+    return false;
+  };
+  auto getSigned = [&getVarint](std::int64_t &value) -> bool
+  {
+    std::uint64_t raw;
+    if (!getVarint(raw))
+    {
+      return false;
+    }
+    value = static_cast<std::int64_t>(raw >> 1) ^ -static_cast<std::int64_t>(raw & 1);
+    return true;
+  };
+
+  char magic[sizeof(DELTA_MAGIC)];
+  std::uint8_t version;
+  std::uint64_t registerQnt, renameRegisterQnt, windowSize, firstCycle = 1;
+  if (!in.read(magic, sizeof(magic)) || std::string(magic, sizeof(magic)) != std::string(DELTA_MAGIC, sizeof(DELTA_MAGIC)))
+  {
+    error = "não é um arquivo delta";
+    return false;
+  }
+  if (!getByte(version) || version < 1 || version > DELTA_VERSION)
+  {
+    error = "versão do formato delta não suportada";
+    return false;
+  }
+  if (!getVarint(registerQnt) || !getVarint(renameRegisterQnt) || !getVarint(windowSize) || windowSize == 0 ||
+      2 * registerQnt + renameRegisterQnt >= NO_REGISTER || (version >= 2 && (!getVarint(firstCycle) || firstCycle == 0)))
+  {
+    error = "cabeçalho inválido";
+    return false;
+  }
+
+  // Cópia do estado do simulador
+  std::vector<Operation> window(windowSize);
+  RegisterFile registers(static_cast<int>(registerQnt), static_cast<int>(renameRegisterQnt), 0);
+
+  std::uint64_t issued = 0;
+  int cycle = static_cast<int>(firstCycle) - 1;
+  int printed = cycle;
+  auto printUntil = [&](int last)
+  {
+    for (; printed < last; printed++)
+    {
+      size_t first = issued > window.size() ? issued - window.size() : 0;
+      writeStateReport(out, printed + 1, window, first, issued, registers, static_cast<int>(registerQnt));
+    }
+  };
+  auto getOperation = [&](Operation *&op) -> bool
+  {
+    std::uint64_t distance;
+    if (!getVarint(distance) || distance == 0 || distance > issued || distance > window.size())
+    {
+      return false;
+    }
+    op = &window[(issued - distance) % window.size()];
+    return true;
+  };
+
+  std::uint8_t record;
+  while (getByte(record))
+  {
+    bool ok = true;
+    Operation *op = nullptr;
+    std::uint64_t value;
+    switch (static_cast<DeltaRecord>(record))
+    {
+    case DeltaRecord::Cycle:
+      ok = getVarint(value) && value > 0;
+      if (ok)
+      {
+        printUntil(cycle);
+        cycle += static_cast<int>(value);
+        printUntil(cycle - 1);
+      }
+      break;
+    case DeltaRecord::Issue:
+    {
+      std::uint8_t fields[4];
+      std::int64_t imm;
+      ok = getByte(fields[0]) && getByte(fields[1]) && getByte(fields[2]) && getByte(fields[3]) && getSigned(imm) &&
+           fields[0] <= static_cast<std::uint8_t>(OpCode::Sw);
+      if (ok)
+      {
+        Instruction inst{static_cast<OpCode>(fields[0]), fields[1], fields[2], fields[3], static_cast<std::int32_t>(imm)};
+        Operation &slot = window[issued % window.size()];
+        slot = Operation(inst);
+        slot.seq = issued;
+        slot.isIssued = true;
+        issued++;
+      }
+      break;
+    }
+    case DeltaRecord::Dispatch:
+      ok = getOperation(op);
+      if (ok)
+      {
+        op->isExecuting = true;
+      }
+      break;
+    case DeltaRecord::ExecEnd:
+      ok = getOperation(op);
+      if (ok)
+      {
+        op->isExecuting = false;
+      }
+      break;
+    case DeltaRecord::Complete:
+      ok = getOperation(op);
+      if (ok)
+      {
+        op->isCompleted = true;
+      }
+      break;
+    case DeltaRecord::Register:
+    {
+      std::uint8_t index, flags;
+      ok = getByte(index) && getByte(flags) && index < registers.size();
+      if (!ok)
+      {
+        break;
+      }
+      registers.setReaders(index, (flags & DELTA_REG_READ) ? 1 : 0);
+      registers.setWriting(index, (flags & DELTA_REG_WRITE) != 0);
+      if (flags & DELTA_REG_VALUE)
+      {
+        std::int64_t regValue = 0;
+        ok = getSigned(regValue);
+        registers.value[index] = static_cast<int>(regValue);
+      }
+      if (ok && (flags & DELTA_REG_INSTRUCTION))
+      {
+        ok = getVarint(value) && value <= issued && value <= window.size();
+        registers.instruction[index] = value ? &window[(issued - value) % window.size()] : nullptr;
+      }
+      break;
+    }
+    case DeltaRecord::End:
+    {
+      std::uint8_t complete = 1; // Antes da versão 3 o registro End só era gravado ao fim da execução
+      ok = getVarint(value) && (version < 3 || (getByte(complete) && complete <= 1));
+      if (ok)
+      {
+        printUntil(static_cast<int>(value));
+        if (complete)
+        {
+          out << "\nExecução completa\n";
+        }
+        return true;
+      }
+      break;
+    }
+    default:
+      ok = false;
+    }
+
+    if (!ok)
+    {
+      error = "registro inválido na posição " + std::to_string(static_cast<long long>(in.tellg()));
+      return false;
+    }
+  }
+
+  error = "arquivo truncado";
+  return false;
+}
+
+#endif
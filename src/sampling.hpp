@@ -0,0 +1,264 @@
+#ifndef TOMASULO_SAMPLING_HPP
+#define TOMASULO_SAMPLING_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "config.hpp"
+#include "functional.hpp"
+#include "scheduler.hpp"
+
+// Entrega no máximo `remaining` instruções de outra fonte
+class LimitedTrace : public TraceSource
+{
+public:
+  TraceSource &source;
+  std::uint64_t remaining;
+
+  LimitedTrace(TraceSource &source, std::uint64_t count)
+      : source(source), remaining(count) {}
+
+  bool next(Instruction &inst) override
+  {
+    if (remaining == 0 || !source.next(inst))
+    {
+      return false;
+    }
+    remaining--;
+    return true;
+  }
+};
+
+/**
+ * @brief Onde simular em detalhe.
+ *
+ * Cada amostra começa com `warmup` instruções simuladas em detalhe e não medidas, que enchem a
+ * janela e as estações, seguidas de `size` instruções medidas. As amostras começam a cada
+ * `period` instruções ou nas posições de `starts`, em ordem crescente.
+ */
+struct SamplingPlan
+{
+  std::uint64_t period = 0;
+  std::uint64_t size = 0;
+  std::uint64_t warmup = 0;
+  std::vector<std::uint64_t> starts;
+};
+
+// Medida de uma amostra detalhada
+struct SampleResult
+{
+  std::uint64_t start;        // Primeira instrução da amostra (incluindo o aquecimento)
+  std::uint64_t instructions; // Instruções medidas
+  std::uint64_t cycles;       // Ciclos entre a retirada da última instrução de aquecimento e a da última medida
+};
+
+struct SamplingResult
+{
+  std::uint64_t instructions = 0;         // Instruções do programa
+  std::uint64_t detailedInstructions = 0; // Instruções simuladas em detalhe (com aquecimento)
+  std::vector<SampleResult> samples;
+
+  double cpiMean() const
+  {
+    double sum = 0.0;
+    for (const auto &sample : samples)
+    {
+      sum += static_cast<double>(sample.cycles) / sample.instructions;
+    }
+    return samples.empty() ? 0.0 : sum / samples.size();
+  }
+
+  // Meia largura do intervalo de 95% de confiança da média do CPI (t de Student)
+  double cpiHalfWidth() const
+  {
+    if (samples.size() < 2)
+    {
+      return 0.0;
+    }
+    double mean = cpiMean();
+    double squares = 0.0;
+    for (const auto &sample : samples)
+    {
+      double deviation = static_cast<double>(sample.cycles) / sample.instructions - mean;
+      squares += deviation * deviation;
+    }
+    double deviation = std::sqrt(squares / (samples.size() - 1));
+    return studentT95(samples.size() - 1) * deviation / std::sqrt(static_cast<double>(samples.size()));
+  }
+
+  // Quantil 97,5% da distribuição t com `freedom` graus de liberdade
+  static double studentT95(size_t freedom)
+  {
+    static const double TABLE[] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                                   2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+                                   2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+    return freedom <= 30 ? TABLE[freedom - 1] : 1.960;
+  }
+};
+
+// Interpreta um inteiro sem sinal de 64 bits
+inline bool parseCount(const std::string &text, std::uint64_t &value)
+{
+  if (text.empty() || text.find_first_not_of("0123456789") != std::string::npos)
+  {
+    return false;
+  }
+  try
+  {
+    value = std::stoull(text);
+    return true;
+  }
+  catch (const std::exception &)
+  {
+    return false;
+  }
+}
+
+/**
+ * @brief Interpreta a amostragem periódica "PERIODO:TAMANHO[:AQUECIMENTO]" ou, com `explicitStarts`,
+ * a lista "INICIO[,INICIO...]:TAMANHO[:AQUECIMENTO]".
+ */
+inline bool parseSamplingPlan(const std::string &spec, bool explicitStarts, SamplingPlan &plan, std::string &error)
+{
+  std::vector<std::string> fields;
+  std::stringstream stream(spec);
+  std::string field;
+  while (std::getline(stream, field, ':'))
+  {
+    fields.push_back(field);
+  }
+
+  plan = SamplingPlan();
+  bool ok = (fields.size() == 2 || fields.size() == 3) && parseCount(fields[1], plan.size) && plan.size > 0 &&
+            (fields.size() == 2 || parseCount(fields[2], plan.warmup));
+  if (ok && explicitStarts)
+  {
+    std::stringstream starts(fields[0]);
+    while (ok && std::getline(starts, field, ','))
+    {
+      std::uint64_t start;
+      ok = parseCount(field, start) &&
+           (plan.starts.empty() || start >= plan.starts.back() + plan.warmup + plan.size);
+      plan.starts.push_back(start);
+    }
+  }
+  else if (ok)
+  {
+    ok = parseCount(fields[0], plan.period) && plan.period >= plan.warmup + plan.size;
+  }
+  if (!ok)
+  {
+    error = "amostragem inválida '" + spec + "' (as amostras não podem se sobrepor)";
+  }
+  return ok;
+}
+
+/**
+ * @brief Simula o programa alternando execução funcional e amostras detalhadas.
+ *
+ * Entre as amostras as instruções são executadas pelo FunctionalSimulator. Em cada amostra o estado
+ * arquitetural e as caches são copiados para um Scheduler novo, que simula o aquecimento e as
+ * instruções medidas até esvaziar a janela; o estado final volta para a execução funcional. O CPI
+ * de cada amostra considera apenas os ciclos entre a retirada da última instrução de aquecimento e
+ * a da última instrução medida.
+ */
+inline SamplingResult runSampled(TraceSource &trace, const SchedulerConfig &config, const SamplingPlan &plan)
+{
+  SamplingResult result;
+  FunctionalSimulator functional(config);
+  std::ostream discard(nullptr);
+  size_t nextStart = 0;
+  bool traceDone = false;
+  while (!traceDone)
+  {
+    // Avança funcionalmente até o início da próxima amostra
+    std::uint64_t start;
+    if (plan.starts.empty())
+    {
+      start = (functional.executed + plan.period - 1) / plan.period * plan.period;
+    }
+    else
+    {
+      start = nextStart < plan.starts.size() ? plan.starts[nextStart++] : UINT64_MAX;
+    }
+    std::uint64_t gap = start - functional.executed;
+    traceDone = functional.run(trace, gap) < gap;
+    if (traceDone)
+    {
+      break;
+    }
+
+    LimitedTrace window(trace, plan.warmup + plan.size);
+    Scheduler scheduler(window, discard, OutputFormat::None, false, config);
+    functional.copyTo(scheduler);
+    int measureStart = plan.warmup == 0 ? 0 : -1;
+    while (!scheduler.isExecutionComplete() && !scheduler.deadlocked)
+    {
+      scheduler.runUntil(scheduler.cycle);
+      if (measureStart < 0 && scheduler.retired >= plan.warmup)
+      {
+        measureStart = scheduler.totalCycles();
+      }
+    }
+    if (scheduler.deadlocked)
+    {
+      trace.error = window.error;
+      break;
+    }
+    functional.copyFrom(scheduler);
+    functional.executed += scheduler.completedCount;
+    result.detailedInstructions += scheduler.completedCount;
+
+    traceDone = window.remaining > 0;
+    if (scheduler.completedCount > plan.warmup)
+    {
+      result.samples.push_back(SampleResult{start, scheduler.completedCount - plan.warmup,
+                                            static_cast<std::uint64_t>(scheduler.totalCycles() - measureStart)});
+    }
+  }
+  result.instructions = functional.executed;
+  return result;
+}
+
+// Escreve o resultado da simulação por amostragem como texto ou JSON
+inline void writeSamplingReport(std::ostream &out, const SamplingResult &result, bool json)
+{
+  double cpi = result.cpiMean();
+  double halfWidth = result.cpiHalfWidth();
+  double cycles = cpi * result.instructions;
+  if (json)
+  {
+    out << "{\"instrucoes\":" << result.instructions << ",\"instrucoes_detalhadas\":" << result.detailedInstructions
+        << ",\"cpi\":" << cpi << ",\"cpi_ic95\":" << halfWidth << ",\"ciclos_estimados\":" << cycles
+        << ",\"ciclos_ic95\":" << halfWidth * result.instructions << ",\"amostras\":[";
+    for (size_t i = 0; i < result.samples.size(); i++)
+    {
+      const SampleResult &sample = result.samples[i];
+      out << (i ? "," : "") << "{\"inicio\":" << sample.start << ",\"instrucoes\":" << sample.instructions
+          << ",\"ciclos\":" << sample.cycles << "}";
+    }
+    out << "]}\n";
+    return;
+  }
+
+  out << "> Simulação por amostragem\n" << std::fixed;
+  writeLabel(out, "Instruções") << result.instructions << "\n";
+  writeLabel(out, "Instruções simuladas em detalhe") << result.detailedInstructions << "\n";
+  writeLabel(out, "Amostras") << result.samples.size() << "\n";
+  writeLabel(out, "CPI estimado (IC 95%)") << std::setprecision(4) << cpi << " ± " << halfWidth << "\n";
+  writeLabel(out, "Ciclos estimados (IC 95%)") << std::setprecision(0) << cycles << " ± "
+                                                 << halfWidth * result.instructions << "\n";
+  out << "\n> Amostras (início, instruções, ciclos, CPI)\n" << std::setprecision(4);
+  for (const auto &sample : result.samples)
+  {
+    out << sample.start << " " << sample.instructions << " " << sample.cycles << " "
+        << static_cast<double>(sample.cycles) / sample.instructions << "\n";
+  }
+  out << std::defaultfloat << std::setprecision(6);
+}
+
+#endif
@@ -0,0 +1,1149 @@
+#ifndef TOMASULO_SCHEDULER_HPP
+#define TOMASULO_SCHEDULER_HPP
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <queue>
+#include <functional>
+#include <iomanip>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include <utility>
+
+#include "machine.hpp"
+#include "memory.hpp"
+#include "observer.hpp"
+#include "state.hpp"
+#include "report.hpp"
+#include "stats.hpp"
+
+/**
+ * @brief Implementação do algoritmo de Tomasulo.
+ *
+ * O observador recebe os eventos de cada instrução (ver NullObserver). Ele é um parâmetro do
+ * template para que as chamadas sejam resolvidas em tempo de compilação: com o NullObserver do
+ * alias Scheduler elas desaparecem do código gerado. A máquina fornece os parâmetros consultados
+ * no laço da simulação: RuntimeMachine os lê da configuração e FixedMachine os fixa na compilação.
+ */
+template <typename Observer = NullObserver, typename Machine = RuntimeMachine>
+class BasicScheduler
+{
+public:
+  Machine machine;                           // Parâmetros consultados no laço da simulação
+  SchedulerConfig config;                    // Parâmetros da máquina simulada
+  TraceSource &trace;                        // Fonte das instruções, lida conforme a janela esvazia
+  std::vector<Operation> window;             // Janela de instruções em voo (buffer circular)
+  UnitPool addUnits;                         // Unidades funcionais de soma
+  UnitPool mulUnits;                         // Unidades funcionais de multiplicação
+  UnitPool swUnits;                          // Unidades funcionais de store/load
+  ReservationStations addStations;           // Estações de reserva das unidades de soma
+  ReservationStations mulStations;           // Estações de reserva das unidades de multiplicação
+  ReservationStations swStations;            // Estações de reserva das unidades de store/load
+  RegisterFile registers;                    // Registradores físicos: arquiteturais seguidos dos temporários
+  std::vector<std::uint8_t> rat;             // Tabela de renomeação: registrador físico de cada registrador arquitetural
+  std::vector<std::uint8_t> aliasOf;         // Registrador arquitetural de cada temporário alocado
+  std::vector<std::uint8_t> freeList;        // Temporários livres para renomeação
+  size_t nextIssue;                          // Número de sequência da próxima instrução a ser emitida
+  size_t retired;                            // Instruções concluídas e retiradas da janela, em ordem
+  size_t completedCount;                     // Instruções concluídas
+  Instruction pending;                       // Próxima instrução já lida, aguardando emissão
+  bool hasPending;                           // Indica se pending é válida
+  bool traceDone;                            // Indica que o arquivo de instruções terminou
+  int cycle;                                 // Ciclo atual
+  std::vector<int> cacheMem;                 // Cache de memória simulada
+  MemoryHierarchy memory;                    // Caches L1/L2, usadas para o tempo de lw e sw
+  MemoryPort *sharedMemory;                  // Memória comum a outros núcleos (nullptr: cacheMem e memory próprias)
+  SharedUnits *sharedUnits;                  // Unidades divididas com outras threads SMT, por tipo (nullptr: próprias)
+  LoadStoreQueue lsq;                        // lw e sw em voo, em ordem de programa
+  std::ostream &outputFile;                  // Referência para o arquivo de saída
+  OutputFormat format;                       // Formato do arquivo de saída
+  DeltaWriter delta;                         // Escritor usado no formato delta
+  bool eventDriven;                          // Pula os ciclos em que nenhum estado muda
+  bool changed;                              // Indica se algum estado mudou no ciclo atual
+  bool deadlocked;                           // Nenhuma instrução pode mais avançar (ver isDeadlocked)
+  SchedulerStats stats;                      // Contadores de desempenho
+  Observer observer;                         // Recebe os eventos das instruções
+
+  // Unidades com resultado pronto no ciclo atual, candidatas ao barramento comum (CDB)
+  std::vector<std::pair<UnitPool *, size_t>> finished;
+  std::vector<size_t> finishedSeqs;
+
+  // Ciclos em que as instruções em execução terminam ou uma unidade pipelinizada volta a aceitar (min-heap)
+  std::priority_queue<int, std::vector<int>, std::greater<int>> events;
+
+  // Com FixedMachine a configuração pedida é ignorada e a simulação usa a da máquina
+  BasicScheduler(TraceSource &trace, std::ostream &outputFile, OutputFormat format = OutputFormat::Text,
+                 bool eventDriven = false, const SchedulerConfig &requested = SchedulerConfig(),
+                 Observer observer = Observer())
+      : machine(requested), config(machine.config()), trace(trace), window(config.windowSize),
+        addUnits(UnitType::Add, config.addUnitClock, config.addUnitQnt, config.addUnitII),
+        mulUnits(UnitType::Mul, config.mulUnitClock, config.mulUnitQnt, config.mulUnitII),
+        swUnits(UnitType::Sw, config.swUnitClock, config.swUnitQnt, config.swUnitII),
+        addStations(config.addRsQnt, config.archRegisterQnt() + config.renameRegisterQnt),
+        mulStations(config.mulRsQnt, config.archRegisterQnt() + config.renameRegisterQnt),
+        swStations(config.swRsQnt, config.archRegisterQnt() + config.renameRegisterQnt),
+        registers(config.registerQnt, config.renameRegisterQnt, INITIAL_REGISTER_VALUE), nextIssue(0), retired(0),
+        completedCount(0), pending(), hasPending(false), traceDone(false), cycle(1),
+        cacheMem(MEMORY_WORDS, INITIAL_MEMORY_VALUE), memory(config), sharedMemory(nullptr), sharedUnits(nullptr), lsq(config.lsqSize),
+        outputFile(outputFile), format(format), delta(outputFile), eventDriven(eventDriven), changed(false),
+        deadlocked(false), observer(std::move(observer))
+  {
+    if (format == OutputFormat::Delta)
+    {
+      delta.begin(config.registerQnt, config.renameRegisterQnt, window.size());
+    }
+
+    finished.reserve(addUnits.size() + mulUnits.size() + swUnits.size());
+    finishedSeqs.reserve(finished.capacity());
+
+    // Inicialmente cada registrador arquitetural é mapeado para si mesmo
+    aliasOf.assign(registers.size(), NO_REGISTER);
+    for (int i = 0; i < config.archRegisterQnt(); i++)
+    {
+      rat.push_back(static_cast<std::uint8_t>(i));
+    }
+    for (int i = static_cast<int>(registers.size()) - 1; i >= config.archRegisterQnt(); i--)
+    {
+      freeList.push_back(static_cast<std::uint8_t>(i));
+    }
+  }
+
+  // Unidades e registradores guardam ponteiros para posições da janela desta instância
+  BasicScheduler(const BasicScheduler &) = delete;
+  BasicScheduler &operator=(const BasicScheduler &) = delete;
+
+  // Executa o algoritmo de Tomasulo
+  void run()
+  {
+    runUntil(std::numeric_limits<int>::max() - 1);
+    finish();
+  }
+
+  /**
+   * @brief Simula até o fim do ciclo `lastCycle` ou até todas as instruções serem concluídas.
+   *
+   * Ao retornar o estado é o do início do ciclo seguinte, então a simulação pode continuar com
+   * outra chamada ou ser salva em um checkpoint. O modo dirigido a eventos nunca pula além desse
+   * ciclo. Se a simulação travar (ver isDeadlocked) ela para com o erro registrado na fonte.
+   *
+   * @return true se a execução está completa ou travou.
+   */
+  bool runUntil(int lastCycle)
+  {
+    while (!isExecutionComplete() && !deadlocked && cycle <= lastCycle) // Continua até que todas as instruções sejam concluídas
+    {
+      beginCycle();
+      issue();    // Estágio de emissão
+      execute();  // Estágio de execução
+      write();    // Estágio de escrita
+      bool stuck = isDeadlocked();
+      endCycle(); // Exibe o estado atual e avança o ciclo
+      if (stuck)
+      {
+        reportDeadlock();
+        break;
+      }
+
+      if (eventDriven)
+      {
+        discardPastEvents();
+        if (!changed)
+        {
+          skipIdleCycles(lastCycle + 1);
+        }
+      }
+    }
+    return isExecutionComplete() || deadlocked;
+  }
+
+  /**
+   * @brief Indica se o ciclo atual terminou sem progresso possível.
+   *
+   * Só a escrita de um resultado libera estações, temporários e unidades. Se nenhum estágio mudou o
+   * estado, nenhuma unidade está ocupada e nenhuma unidade pipelinizada voltará a aceitar
+   * instruções, os ciclos seguintes repetem este para sempre (por exemplo, um destino que precisa de
+   * renomeação sem temporário que possa ser liberado). Deve ser chamada antes de endCycle().
+   */
+  bool isDeadlocked() const
+  {
+    if (changed || isExecutionComplete())
+    {
+      return false;
+    }
+    for (const UnitPool *units : {&addUnits, &mulUnits, &swUnits})
+    {
+      if (units->busy.any())
+      {
+        return false;
+      }
+      for (int accept : units->nextAccept)
+      {
+        if (accept > cycle)
+        {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  // Para a simulação travada e descreve, na fonte de instruções, o que impede a emissão
+  void reportDeadlock()
+  {
+    deadlocked = true;
+    std::string causes;
+    for (int i = 0; i < STALL_CAUSE_QNT; i++)
+    {
+      if (stats.cycleStall[i])
+      {
+        causes += (causes.empty() ? "" : ", ") + std::string(STALL_DESCRIPTIONS[i]);
+      }
+    }
+    trace.error = "simulação: nenhuma instrução pode avançar a partir do ciclo " + std::to_string(cycle - 1) +
+                  (causes.empty() ? "" : "; causas: " + causes);
+  }
+
+  // Prepara os indicadores do ciclo antes dos estágios
+  void beginCycle()
+  {
+    changed = false;
+    stats.beginCycle();
+  }
+
+  // Fecha os contadores do ciclo, registra o estado na saída e avança o relógio
+  void endCycle()
+  {
+    stats.endCycle(busyRegisterCount(), machine.renameRegisterQnt() - static_cast<int>(freeList.size()));
+    showState();
+    cycle++;
+  }
+
+  /**
+   * @brief Simula um único ciclo.
+   *
+   * @return false se a execução está completa, de modo que `while (scheduler.step())` simula o
+   * programa inteiro.
+   */
+  bool step()
+  {
+    return !runUntil(cycle);
+  }
+
+  // Encerra o arquivo de saída depois do último ciclo simulado
+  void finish()
+  {
+    if (format == OutputFormat::Delta)
+    {
+      delta.finish(cycle - 1, isExecutionComplete());
+    }
+    else if (format == OutputFormat::Text && isExecutionComplete())
+    {
+      outputFile << "\nExecução completa\n"; // Log de execução completa
+    }
+  }
+
+  // Total de ciclos simulados
+  int totalCycles() const
+  {
+    return cycle - 1;
+  }
+
+  // Instruções concluídas por ciclo
+  double ipc() const
+  {
+    return totalCycles() > 0 ? static_cast<double>(completedCount) / totalCycles() : 0.0;
+  }
+
+  // Registradores físicos com leitores ou escritor pendentes
+  int busyRegisterCount() const
+  {
+    return static_cast<int>(registers.busy.count());
+  }
+
+  // Unidades funcionais por tipo, para os relatórios de desempenho
+  std::vector<UnitGroup> unitGroups() const
+  {
+    return {{"ADD", &addUnits}, {"MUL", &mulUnits}, {"SW", &swUnits}};
+  }
+
+  // Escreve os contadores de desempenho como resumo legível ou JSON
+  void writeStats(std::ostream &out, bool json) const
+  {
+    if (json)
+    {
+      writeStatsJson(out, stats, totalCycles(), completedCount, unitGroups(), memory);
+    }
+    else
+    {
+      writeStatsSummary(out, stats, totalCycles(), completedCount, unitGroups(), memory);
+    }
+  }
+
+  /**
+   * @brief Avança o relógio direto para o próximo ciclo em que algum estado pode mudar.
+   *
+   * Se nenhum estágio alterou o estado no ciclo anterior, emissão e despacho continuarão sem efeito
+   * até que alguma instrução termine de executar, pois só a escrita libera unidades, registradores
+   * e temporários. O próximo ciclo relevante é o menor ciclo de conclusão na fila de eventos; os
+   * ciclos intermediários só decrementam os ciclos restantes das unidades, o que é feito de uma vez. No formato texto o
+   * estado desses ciclos continua sendo registrado para que a saída seja idêntica ao modo ciclo a
+   * ciclo; no formato delta ciclos sem mudanças não geram registros.
+   *
+   * @param limit Ciclo máximo a alcançar.
+   */
+  void skipIdleCycles(int limit)
+  {
+    if (events.empty() || events.top() <= cycle || limit <= cycle)
+    {
+      return;
+    }
+
+    int skip = std::min(events.top(), limit) - cycle;
+    for (UnitPool *units : {&addUnits, &mulUnits, &swUnits})
+    {
+      units->busy.forEachSet([units, skip](size_t i)
+                             {
+                               if (units->instruction[i]->isExecuting)
+                               {
+                                 units->remaining[i] -= skip;
+                               }
+                               units->busyCycles[i] += skip; });
+    }
+    stats.repeatCycle(skip);
+    if (format != OutputFormat::Text)
+    {
+      cycle += skip;
+      return;
+    }
+    for (int i = 0; i < skip; i++)
+    {
+      showState();
+      cycle++;
+    }
+  }
+
+  /**
+   * @brief Prepara a continuação da simulação depois que o estado foi restaurado de um checkpoint.
+   *
+   * Descarta da fonte as instruções já lidas, recria a fila de eventos a partir das unidades em
+   * execução e, no formato delta, reinicia o arquivo no ciclo atual com as instruções da janela,
+   * para que ele possa ser decodificado sozinho.
+   *
+   * @return false se a fonte tiver menos instruções do que as já lidas no checkpoint.
+   */
+  bool resume()
+  {
+    size_t consumed = nextIssue + (hasPending ? 1 : 0);
+    bool complete = trace.skip(consumed) == consumed;
+
+    events = decltype(events)();
+    for (UnitPool *units : {&addUnits, &mulUnits, &swUnits})
+    {
+      units->busy.forEachSet([this, units](size_t i)
+                             {
+                               if (units->instruction[i]->isExecuting)
+                               {
+                                 events.push(cycle + units->remaining[i] - 1);
+                               } });
+      for (int accept : units->nextAccept)
+      {
+        if (units->depth > 1 && accept > cycle)
+        {
+          events.push(accept);
+        }
+      }
+    }
+
+    if (format == OutputFormat::Delta)
+    {
+      delta.buffer.clear();
+      delta.begin(config.registerQnt, config.renameRegisterQnt, window.size(), cycle);
+      delta.issued = firstVisible();
+      for (size_t seq = firstVisible(); seq < nextIssue; seq++)
+      {
+        const Operation &instruction = slot(seq);
+        delta.issue(cycle, instruction.inst);
+        if (instruction.isExecuting)
+        {
+          delta.dispatch(cycle, seq);
+        }
+        if (instruction.isCompleted)
+        {
+          delta.complete(cycle, seq);
+        }
+      }
+    }
+    return complete;
+  }
+
+  // Remove da fila os eventos de ciclos já simulados, mantendo-a limitada às unidades ocupadas
+  void discardPastEvents()
+  {
+    while (!events.empty() && events.top() < cycle)
+    {
+      events.pop();
+    }
+  }
+
+  // Registra o estado do ciclo atual no arquivo de saída
+  void showState()
+  {
+    if (format == OutputFormat::Delta)
+    {
+      delta.registers(cycle, registers);
+    }
+    else if (format == OutputFormat::Text)
+    {
+      writeStateReport(outputFile, cycle, window, firstVisible(), nextIssue, registers, config.registerQnt);
+    }
+  }
+
+  // Verifica se a execução está completa: todas as instruções lidas foram retiradas
+  bool isExecutionComplete() const
+  {
+    return traceDone && !hasPending && retired == nextIssue;
+  }
+
+  // Posição da instrução na janela circular
+  Operation &slot(size_t seq)
+  {
+    return window[seq % machine.windowSize()];
+  }
+
+  // Primeira instrução ainda guardada na janela (as retiradas permanecem até serem sobrescritas)
+  size_t firstVisible() const
+  {
+    return nextIssue > machine.windowSize() ? nextIssue - machine.windowSize() : 0;
+  }
+
+  /**
+   * @brief Retira, em ordem de programa, as instruções concluídas no início da janela.
+   *
+   * lw e sw saem também da fila de loads e stores; é na retirada que um sw escreve na memória, de
+   * modo que nenhum lw mais antigo enxerga o valor. Com COMMIT_WIDTH no máximo essa quantidade de
+   * instruções é retirada por ciclo e as demais esperam o próximo ciclo.
+   */
+  void retire()
+  {
+    size_t first = retired;
+    size_t limit = machine.commitWidth() > 0 ? retired + machine.commitWidth() : nextIssue;
+    while (retired < nextIssue && retired < limit && slot(retired).isCompleted)
+    {
+      Operation &instruction = slot(retired);
+      if (isMemoryOp(instruction.inst.op))
+      {
+        const LsqEntry &entry = lsqEntry(instruction.memSeq);
+        if (entry.isStore)
+        {
+          storeWord(entry.address, entry.value);
+        }
+        lsq.pop();
+      }
+      retired++;
+    }
+    if (retired != first)
+    {
+      changed = true;
+    }
+  }
+
+  // Posição de uma operação de memória na fila de loads e stores
+  LsqEntry &lsqEntry(size_t memSeq)
+  {
+    return lsq.entries[memSeq % machine.lsqSize()];
+  }
+
+  // Posição da memória de dados acessada pelo endereço (cacheMem tem sempre MEMORY_WORDS palavras)
+  size_t memoryIndex(std::int64_t address) const
+  {
+    return static_cast<size_t>(address) % MEMORY_WORDS;
+  }
+
+  // Endereço de lw/sw: deslocamento mais o registrador base, já disponível
+  std::int64_t effectiveAddress(const Operation &instruction) const
+  {
+    return performOperation(OpCode::Add, instruction.inst.imm, registers.value[instruction.physSrc[1]]);
+  }
+
+  /**
+   * @brief Decide se um lw pronto pode executar e com qual latência.
+   *
+   * Percorre os sw mais antigos da fila, do mais novo para o mais antigo. Um sw com registrador base
+   * ainda não escrito tem endereço desconhecido e o lw espera; o primeiro sw para a mesma posição
+   * encaminha o dado se já o capturou (latência de SW_UNIT_CLOCK), senão o lw espera. Sem sw
+   * anterior para a posição o lw acessa as caches.
+   *
+   * @return Latência de execução ou 0 se o lw deve continuar na estação de reserva.
+   */
+  int resolveLoad(Operation *instruction)
+  {
+    LsqEntry &load = lsqEntry(instruction->memSeq);
+    load.address = effectiveAddress(*instruction);
+    load.addressKnown = true;
+    for (size_t memSeq = instruction->memSeq; memSeq > lsq.head; memSeq--)
+    {
+      const LsqEntry &older = lsqEntry(memSeq - 1);
+      if (!older.isStore)
+      {
+        continue;
+      }
+      if (!older.addressKnown && registers.isWriting(older.op->physSrc[1]))
+      {
+        return 0;
+      }
+      std::int64_t address = older.addressKnown ? older.address : effectiveAddress(*older.op);
+      if (memoryIndex(address) != memoryIndex(load.address))
+      {
+        continue;
+      }
+      if (!older.completed)
+      {
+        return 0;
+      }
+      load.forwarded = true;
+      load.value = older.value;
+      stats.forwardedLoads++;
+      return machine.latency(UnitType::Sw);
+    }
+    return machine.latency(UnitType::Sw) + accessMemory(load.address);
+  }
+
+  // Ciclos além do acerto na L1 de um acesso, pelas caches próprias ou pela memória compartilhada
+  int accessMemory(std::int64_t address)
+  {
+    return sharedMemory ? sharedMemory->access(cycle, address, memory.l1) : memory.access(address);
+  }
+
+  // Valor de uma palavra da memória de dados
+  int loadWord(std::int64_t address) const
+  {
+    return sharedMemory ? sharedMemory->load(memoryIndex(address)) : cacheMem[memoryIndex(address)];
+  }
+
+  // Escreve uma palavra na memória de dados (na retirada de um sw)
+  void storeWord(std::int64_t address, int value)
+  {
+    if (sharedMemory)
+    {
+      sharedMemory->store(cycle, memoryIndex(address), value);
+    }
+    else
+    {
+      cacheMem[memoryIndex(address)] = value;
+    }
+    accessMemory(address);
+  }
+
+  // Indica se o registrador físico possui leitores ou escritor pendentes
+  bool isBusy(std::uint8_t phys)
+  {
+    return registers.isBusy(phys);
+  }
+
+  // Indica se o registrador físico é um temporário de renomeação
+  bool isTempRegister(std::uint8_t phys)
+  {
+    return phys >= machine.archRegisterQnt();
+  }
+
+  /**
+   * @brief Aloca um registrador temporário para o destino de uma instrução (dependência falsa).
+   *
+   * Retira um registrador da lista livre e atualiza a tabela de renomeação (RAT) para que as próximas
+   * instruções que leiam o registrador arquitetural usem o temporário. As instruções nunca são
+   * reescritas: cada uma guarda as tags físicas obtidas na emissão, então o custo é constante.
+   *
+   * @param arch Índice do registrador arquitetural de destino.
+   * @return Registrador físico alocado ou NO_REGISTER se não houver temporário livre.
+   */
+  std::uint8_t renameRegister(std::uint8_t arch)
+  {
+    if (freeList.empty())
+    {
+      return NO_REGISTER;
+    }
+    std::uint8_t phys = freeList.back();
+    freeList.pop_back();
+    aliasOf[phys] = arch;
+    rat[arch] = phys;
+    return phys;
+  }
+
+  /**
+   * @brief Devolve um registrador arquitetural ao seu registrador de origem.
+   *
+   * Quando o temporário que contém o valor mais recente já foi escrito e o registrador de origem
+   * não tem leitores nem escritor pendentes, o valor é copiado de volta e a RAT volta a apontar
+   * para o registrador de origem. O temporário é liberado assim que seus leitores terminarem.
+   *
+   * @param arch Índice do registrador arquitetural.
+   */
+  void returnRenamed(std::uint8_t arch)
+  {
+    std::uint8_t phys = rat[arch];
+    if (phys == arch || registers.isWriting(phys) || isBusy(arch))
+    {
+      return;
+    }
+    registers.value[arch] = registers.value[phys];
+    observer.registerWrite(cycle, arch, registers.value[arch]);
+    rat[arch] = arch;
+    releaseRegister(phys);
+  }
+
+  // Devolve um temporário à lista livre se ele não estiver mapeado nem em uso
+  void releaseRegister(std::uint8_t phys)
+  {
+    if (!isTempRegister(phys) || aliasOf[phys] == NO_REGISTER || isBusy(phys) || rat[aliasOf[phys]] == phys)
+    {
+      return;
+    }
+    aliasOf[phys] = NO_REGISTER;
+    registers.instruction[phys] = nullptr;
+    freeList.push_back(phys);
+  }
+
+  // Remove um leitor pendente do registrador físico
+  void releaseRead(std::uint8_t phys)
+  {
+    if (phys == NO_REGISTER)
+    {
+      return;
+    }
+    registers.removeReader(phys);
+    registerIdle(phys);
+  }
+
+  // Libera ou devolve o registrador físico quando ele não tiver mais leitores nem escritor
+  void registerIdle(std::uint8_t phys)
+  {
+    if (isBusy(phys))
+    {
+      return;
+    }
+    registers.instruction[phys] = nullptr;
+    if (isTempRegister(phys))
+    {
+      releaseRegister(phys);
+    }
+    else
+    {
+      returnRenamed(phys);
+    }
+  }
+
+  // Salva a tabela de renomeação e a lista livre
+  RatCheckpoint checkpointRat() const
+  {
+    return RatCheckpoint{rat, aliasOf, freeList};
+  }
+
+  // Restaura a tabela de renomeação e a lista livre salvas por checkpointRat()
+  void restoreRat(const RatCheckpoint &checkpoint)
+  {
+    rat = checkpoint.rat;
+    aliasOf = checkpoint.aliasOf;
+    freeList = checkpoint.freeList;
+  }
+
+  // Faz o estágio de emissão (issue)
+  /**
+   * @brief Despacha instruções das estações de reserva e emite a próxima instrução do programa.
+   *
+   * Primeiro, em cada classe de unidades, as instruções prontas (sem Qj nem Qk pendentes) mais
+   * antigas são despachadas para as unidades funcionais livres; lw que dependem de um sw anterior
+   * ainda não resolvido continuam nas estações.
+   *
+   * Em seguida emite, em ordem de programa, até ISSUE_WIDTH novas instruções, cada uma para uma
+   * estação de reserva livre da sua classe: os operandos são traduzidos pela RAT para tags físicas
+   * e, se o registrador de destino atual tiver leitores ou escritor pendentes (dependência falsa), o
+   * destino é renomeado para um temporário livre. Sem estação ou temporário livre a emissão para
+   * neste ciclo, e as instruções seguintes esperam.
+   */
+  void issue()
+  {
+    dispatchReady();
+    issueInstructions(machine.issueWidth());
+  }
+
+  // Despacha as instruções prontas de todas as classes de unidades
+  void dispatchReady()
+  {
+    dispatch<UnitType::Add>(addUnits, addStations);
+    dispatch<UnitType::Mul>(mulUnits, mulStations);
+    dispatch<UnitType::Sw>(swUnits, swStations);
+  }
+
+  // Emite até `width` instruções em ordem de programa; retorna quantas foram emitidas
+  size_t issueInstructions(size_t width)
+  {
+    size_t issued = 0;
+    for (; issued < width; issued++)
+    {
+      // Lê a próxima instrução do arquivo se ainda houver espaço na janela
+      if (!hasPending && !traceDone)
+      {
+        hasPending = trace.next(pending);
+        traceDone = !hasPending;
+      }
+      if (!hasPending)
+      {
+        break;
+      }
+      if (nextIssue - retired >= machine.windowSize())
+      {
+        stats.stall(StallCause::WindowFull);
+        break;
+      }
+      if (!emit(pending))
+      {
+        break;
+      }
+    }
+    return issued;
+  }
+
+  /**
+   * @brief Seleciona as instruções prontas mais antigas de uma classe e as despacha.
+   *
+   * As estações prontas são calculadas por operações sobre os conjuntos de bits; a seleção escolhe,
+   * para cada unidade livre, a instrução pronta com menor número de sequência. A estação é liberada
+   * no despacho. A latência de lw depende da fila de loads e stores e das caches. Uma unidade
+   * pipelinizada recebe outra instrução depois do intervalo de iniciação, mesmo com a anterior
+   * ainda executando.
+   */
+  template <UnitType TYPE>
+  void dispatch(UnitPool &units, ReservationStations &stations)
+  {
+    if (!stations.valid.any())
+    {
+      return;
+    }
+    stations.updateReady();
+    if (stations.hasWaiting())
+    {
+      stats.stall(StallCause::Raw);
+    }
+
+    for (size_t unit = findAvailableUnit(units); unit < units.size() && stations.ready.any();
+         unit = findAvailableUnit(units))
+    {
+      size_t oldest = stations.size();
+      stations.ready.forEachSet([&stations, &oldest](size_t i)
+                                {
+                                  if (oldest == stations.size() || stations.operation[i]->seq < stations.operation[oldest]->seq)
+                                  {
+                                    oldest = i;
+                                  } });
+      Operation *instruction = stations.operation[oldest];
+      stations.ready.reset(oldest);
+      int latency = TYPE == UnitType::Sw && instruction->inst.op == OpCode::Lw ? resolveLoad(instruction)
+                                                                                : machine.latency(TYPE);
+      if (latency == 0)
+      {
+        stats.stall(StallCause::MemoryOrder);
+        continue;
+      }
+      stations.release(oldest);
+
+      // Define a instrução como executando
+      instruction->isExecuting = true;
+
+      // Define a unidade funcional como ocupada
+      units.busy.set(unit);
+      units.remaining[unit] = latency;
+      units.instruction[unit] = instruction;
+      units.nextAccept[unit / units.depth] = cycle + units.initiationInterval;
+      if (sharedUnits)
+      {
+        SharedUnits &shared = sharedUnits[static_cast<int>(TYPE)];
+        shared.inUse[unit / units.depth]++;
+        shared.nextAccept[unit / units.depth] = cycle + units.initiationInterval;
+      }
+      changed = true;
+      if (format == OutputFormat::Delta)
+      {
+        delta.dispatch(cycle, instruction->seq);
+      }
+      observer.dispatch(cycle, *instruction, TYPE, unit);
+
+      // A execução termina no ciclo em que os ciclos restantes chegam a zero
+      if (eventDriven)
+      {
+        events.push(cycle + latency - 1);
+        if (units.depth > 1)
+        {
+          events.push(cycle + units.initiationInterval);
+        }
+      }
+    }
+
+    if (stations.ready.any())
+    {
+      stats.stall(StallCause::Structural);
+    }
+  }
+
+  /**
+   * @brief Emite uma instrução na próxima posição da janela, traduzindo seus operandos pela RAT.
+   *
+   * Em sw o registrador "dest" é o valor armazenado e portanto é lido; em lw e sw o primeiro
+   * operando é um deslocamento e não um registrador. A posição da janela só é sobrescrita se a
+   * emissão acontecer. Operandos cujo registrador físico ainda será escrito viram as tags Qj/Qk da
+   * estação de reserva. lw e sw também precisam de uma posição livre na fila de loads e stores.
+   *
+   * @return false se a instrução não pôde ser emitida neste ciclo.
+   */
+  bool emit(const Instruction &inst)
+  {
+    ReservationStations &stations = getStations(OP_UNIT[static_cast<int>(inst.op)]);
+    size_t station = stations.findFree();
+    if (station == stations.size())
+    {
+      stats.stall(StallCause::StationFull);
+      return false;
+    }
+    if (isMemoryOp(inst.op) && lsq.full())
+    {
+      stats.stall(StallCause::LsqFull);
+      return false;
+    }
+
+    std::uint8_t src1 = inst.op == OpCode::Sw ? inst.dest : inst.src1;
+    std::uint8_t physSrc1 = src1 != NO_REGISTER ? rat[src1] : NO_REGISTER;
+    std::uint8_t physSrc2 = rat[inst.src2];
+    std::uint8_t dest = NO_REGISTER;
+
+    if (inst.op != OpCode::Sw)
+    {
+      // Dependência falsa: o destino atual ainda será lido ou escrito
+      dest = rat[inst.dest];
+      if (isBusy(dest) || dest == physSrc1 || dest == physSrc2)
+      {
+        bool waw = registers.isWriting(dest);
+        dest = renameRegister(inst.dest);
+        if (dest == NO_REGISTER)
+        {
+          stats.stall(StallCause::RenameFailure);
+          return false;
+        }
+        if (waw)
+        {
+          stats.wawRenames++;
+        }
+        else
+        {
+          stats.warRenames++;
+        }
+      }
+    }
+
+    Operation *instruction = &slot(nextIssue);
+    *instruction = Operation(inst);
+    instruction->seq = nextIssue;
+    instruction->physSrc[0] = physSrc1;
+    instruction->physSrc[1] = physSrc2;
+    instruction->physDest = dest;
+    if (isMemoryOp(inst.op))
+    {
+      instruction->memSeq = lsq.push(instruction, inst.op == OpCode::Sw);
+    }
+
+    std::uint8_t tagJ = physSrc1 != NO_REGISTER && registers.isWriting(physSrc1) ? physSrc1 : NO_REGISTER;
+    std::uint8_t tagK = registers.isWriting(physSrc2) ? physSrc2 : NO_REGISTER;
+    stations.reserve(station, instruction, tagJ, tagK);
+
+    if (dest != NO_REGISTER)
+    {
+      registers.setWriting(dest, true);
+      registers.instruction[dest] = instruction;
+    }
+
+    for (std::uint8_t src : instruction->physSrc)
+    {
+      if (src != NO_REGISTER)
+      {
+        registers.addReader(src);
+        if (!registers.isWriting(src))
+        {
+          registers.instruction[src] = instruction;
+        }
+      }
+    }
+
+    instruction->isIssued = true;
+    nextIssue++;
+    hasPending = false;
+    changed = true;
+    if (format == OutputFormat::Delta)
+    {
+      delta.issue(cycle, inst);
+    }
+    observer.issue(cycle, *instruction);
+    return true;
+  }
+
+  // Faz o estágio de execução
+  /**
+   * @brief Executa o ciclo de execução das unidades funcionais.
+   *
+   * Esta função percorre todas as unidades funcionais de adição, multiplicação e armazenamento,
+   * decrementando o número de ciclos de execução restantes para cada instrução em execução.
+   * Quando o número de ciclos de execução de uma instrução chega a zero, a instrução é marcada
+   * como não mais em execução.
+   */
+  void execute()
+  {
+    executeUnits(addUnits);
+    executeUnits(mulUnits);
+    executeUnits(swUnits);
+  }
+
+  // Decrementa os ciclos restantes das unidades ocupadas de um tipo
+  void executeUnits(UnitPool &units)
+  {
+    units.busy.forEachSet([this, &units](size_t i)
+                          {
+                            units.busyCycles[i]++;
+                            if (units.instruction[i]->isExecuting && --units.remaining[i] == 0)
+                            {
+                              units.instruction[i]->isExecuting = false;
+                              changed = true;
+                              if (format == OutputFormat::Delta)
+                              {
+                                delta.execEnd(cycle, units.instruction[i]->seq);
+                              }
+                              observer.complete(cycle, *units.instruction[i]);
+                            } });
+  }
+
+  // Faz o estágio de escrita
+  /**
+   * @brief Escreve os resultados prontos pelo barramento comum (CDB) e retira as instruções concluídas.
+   *
+   * No máximo CDB_WIDTH resultados são difundidos por ciclo; se houver mais candidatos, os das
+   * instruções mais antigas têm prioridade e os demais continuam ocupando suas unidades até o
+   * próximo ciclo. Os escolhidos são concluídos na ordem das unidades (soma, multiplicação e
+   * armazenamento).
+   */
+  void write()
+  {
+    writeResults(machine.cdbWidth());
+  }
+
+  // Escreve no máximo `cdbSlots` resultados e retira as instruções concluídas; retorna quantos foram escritos
+  size_t writeResults(size_t cdbSlots)
+  {
+    finished.clear();
+    collectFinished(addUnits);
+    collectFinished(mulUnits);
+    collectFinished(swUnits);
+
+    // Menor número de sequência que não cabe no barramento neste ciclo
+    size_t cutoff = std::numeric_limits<size_t>::max();
+    if (finished.size() > cdbSlots)
+    {
+      stats.stall(StallCause::Cdb);
+      finishedSeqs.clear();
+      for (const auto &candidate : finished)
+      {
+        finishedSeqs.push_back(candidate.first->instruction[candidate.second]->seq);
+      }
+      std::nth_element(finishedSeqs.begin(), finishedSeqs.begin() + cdbSlots, finishedSeqs.end());
+      cutoff = finishedSeqs[cdbSlots];
+    }
+
+    size_t written = 0;
+    for (const auto &candidate : finished)
+    {
+      UnitPool &units = *candidate.first;
+      Operation *instruction = units.instruction[candidate.second];
+      if (instruction->seq < cutoff)
+      {
+        units.busy.reset(candidate.second);
+        if (sharedUnits)
+        {
+          sharedUnits[static_cast<int>(units.type)].inUse[candidate.second / units.depth]--;
+        }
+        complete(instruction);
+        written++;
+      }
+    }
+    retire();
+    return written;
+  }
+
+  // Adiciona aos candidatos ao CDB as unidades cuja instrução terminou de executar
+  void collectFinished(UnitPool &units)
+  {
+    units.busy.forEachSet([this, &units](size_t i)
+                          {
+                            if (!units.instruction[i]->isExecuting)
+                            {
+                              finished.emplace_back(&units, i);
+                            } });
+  }
+
+  /**
+   * @brief Conclui a instrução: escreve o resultado e libera os registradores que ela usava.
+   *
+   * Dependendo da operação da instrução, atualiza o valor do registrador físico de destino ou
+   * guarda o endereço e o dado de um sw na fila de loads e stores, e difunde a tag do destino para as estações de reserva. Libera os registradores
+   * utilizados pela instrução e, se possível, devolve o registrador renomeado.
+   */
+  void complete(Operation *instruction)
+  {
+    instruction->isCompleted = true;
+    changed = true;
+    if (format == OutputFormat::Delta)
+    {
+      delta.complete(cycle, instruction->seq);
+    }
+    observer.writeback(cycle, *instruction);
+
+    // Atualiza o valor do registrador de destino
+    const Instruction &inst = instruction->inst;
+    int src2Value = registers.value[instruction->physSrc[1]];
+
+    if (isMemoryOp(inst.op))
+    {
+      LsqEntry &entry = lsqEntry(instruction->memSeq);
+      if (inst.op == OpCode::Sw)
+      {
+        // A memória só é escrita na retirada
+        entry.address = effectiveAddress(*instruction);
+        entry.addressKnown = true;
+        entry.value = registers.value[instruction->physSrc[0]];
+        entry.completed = true;
+      }
+      else
+      {
+        registers.value[instruction->physDest] = entry.forwarded ? entry.value : loadWord(entry.address);
+      }
+    }
+    else
+    {
+      int src1Value = registers.value[instruction->physSrc[0]];
+      registers.value[instruction->physDest] = performOperation(inst.op, src1Value, src2Value);
+    }
+    if (instruction->physDest != NO_REGISTER)
+    {
+      observer.registerWrite(cycle, instruction->physDest, registers.value[instruction->physDest]);
+    }
+
+    // Libera os registradores utilizados pela instrução
+    if (instruction->physDest != NO_REGISTER)
+    {
+      registers.setWriting(instruction->physDest, false);
+      broadcast(instruction->physDest);
+      if (registers.instruction[instruction->physDest] == instruction)
+      {
+        registers.instruction[instruction->physDest] = nullptr;
+      }
+      if (isTempRegister(instruction->physDest))
+      {
+        returnRenamed(aliasOf[instruction->physDest]);
+      }
+      registerIdle(instruction->physDest);
+    }
+
+    // A posição da janela pode ser reutilizada, então nenhum registrador deve apontar para ela
+    for (std::uint8_t src : instruction->physSrc)
+    {
+      if (src != NO_REGISTER && registers.instruction[src] == instruction)
+      {
+        registers.instruction[src] = nullptr;
+      }
+    }
+    releaseRead(instruction->physSrc[0]);
+    releaseRead(instruction->physSrc[1]);
+    completedCount++;
+  }
+
+  // Difunde no CDB a tag de um registrador físico recém-escrito, acordando as estações dependentes
+  void broadcast(std::uint8_t tag)
+  {
+    addStations.wakeup(tag);
+    mulStations.wakeup(tag);
+    swStations.wakeup(tag);
+  }
+
+  // Obtém as estações de reserva de uma classe de unidades
+  ReservationStations &getStations(UnitType type)
+  {
+    switch (type)
+    {
+    case UnitType::Add:
+      return addStations;
+    case UnitType::Mul:
+      return mulStations;
+    default:
+      return swStations;
+    }
+  }
+
+  /**
+   * @brief Encontra uma posição livre em uma unidade que aceita instruções neste ciclo.
+   *
+   * Com unidades compartilhadas (SMT) a unidade também precisa aceitar instruções considerando as
+   * outras threads; a posição livre é procurada nas posições desta thread.
+   *
+   * @return Índice da posição ou units.size() se todas as unidades estiverem ocupadas.
+   */
+  size_t findAvailableUnit(const UnitPool &units) const
+  {
+    const SharedUnits *shared = sharedUnits ? &sharedUnits[static_cast<int>(units.type)] : nullptr;
+    if (units.depth == 1 && !shared)
+    {
+      return units.busy.findFirstClear();
+    }
+    for (size_t unit = 0; unit < units.unitCount(); unit++)
+    {
+      // Com SMT a unidade pode estar ocupada ou ter aceitado uma instrução de outra thread
+      if (units.nextAccept[unit] > cycle ||
+          (shared && (shared->nextAccept[unit] > cycle || shared->inUse[unit] >= units.depth)))
+      {
+        continue;
+      }
+      for (size_t i = unit * units.depth; i < (unit + 1) * units.depth; i++)
+      {
+        if (!units.busy.test(i))
+        {
+          return i;
+        }
+      }
+    }
+    return units.size();
+  }
+
+  // Obtém o conjunto de unidades funcionais de um tipo
+  UnitPool &getUnits(UnitType type)
+  {
+    switch (type)
+    {
+    case UnitType::Add:
+      return addUnits;
+    case UnitType::Mul:
+      return mulUnits;
+    default:
+      return swUnits;
+    }
+  }
+
+  // Executa a operação matemática
+  int performOperation(OpCode op, int src1, int src2) const
+  {
+    return ::performOperation(op, src1, src2);
+  }
+};
+
+// Simulador sem observador, configurado em tempo de execução
+using Scheduler = BasicScheduler<>;
+
+// Simulador sem observador especializado para a configuração de produção
+using ProductionScheduler = BasicScheduler<NullObserver, ProductionMachine>;
+
+#endif
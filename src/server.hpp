@@ -0,0 +1,552 @@
+#ifndef TOMASULO_SERVER_HPP
+#define TOMASULO_SERVER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "config.hpp"
+#include "engines.hpp"
+#include "instruction.hpp"
+#include "options.hpp"
+#include "report.hpp"
+#include "simulator.hpp"
+#include "sweep.hpp"
+#include "thread_pool.hpp"
+#include "tracefile.hpp"
+
+// Linha que encerra um programa enviado junto com o pedido
+const char SERVER_PROGRAM_END[] = ".";
+
+// Pedido de simulação recebido pelo servidor
+struct ServerJob
+{
+  std::string id;                           // Identificador devolvido na resposta
+  SchedulerConfig config;                   // Configuração do servidor com as alterações do pedido
+  EngineKind engine = EngineKind::Tomasulo;
+  bool eventDriven = false;
+  OutputFormat format = OutputFormat::None; // Formato do arquivo de saída, se houver
+  std::string output;                       // Arquivo de saída (vazio: apenas o resumo)
+  std::string statsFormat;                  // Contadores de desempenho na resposta: "resumo", "json" ou vazio
+  bool inlineProgram = false;               // O programa vem nas linhas seguintes ao pedido
+  std::string tracePath;                    // Arquivo de instruções, se o programa não vier no pedido
+  std::string program;                      // Programa enviado no pedido, uma instrução por linha
+};
+
+// Resposta de erro a um pedido
+inline std::string serverError(const std::string &id, const std::string &error)
+{
+  return "{\"id\":" + jsonString(id) + ",\"erro\":" + jsonString(error) + "}";
+}
+
+// Opções da linha de comando que valem em um pedido; as demais escolhem outros modos do programa
+inline bool isServerRequestOption(const std::string &arg)
+{
+  for (const char *prefix : {"--config=", "--motor=", "--eventos", "--formato=", "--estatisticas"})
+  {
+    if (arg.rfind(prefix, 0) == 0)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Interpreta a linha de um pedido: identificador, opções e arquivo de instruções.
+ *
+ * As opções são lidas por parseCommandLineOption, como na linha de comando, e apenas as que fazem
+ * sentido para uma simulação são aceitas: --config, --motor, --eventos, --formato e --estatisticas.
+ * --saida=nome é própria do pedido e grava o arquivo em `outputDir`, o diretório dado ao servidor
+ * com --saidas; sem esse diretório nenhum pedido grava arquivos. O arquivo de instruções "-"
+ * indica que o programa vem nas linhas seguintes, até uma linha com ".".
+ *
+ * @param job Pedido, já com a configuração base do servidor (entrada e saída).
+ * @return false se o pedido for inválido; o identificador é preenchido sempre que existir.
+ */
+inline bool parseServerRequest(const std::string &line, const std::string &outputDir, ServerJob &job,
+                               std::string &error)
+{
+  std::istringstream input(line);
+  std::vector<std::string> args;
+  std::string outputName;
+  input >> job.id;
+  for (std::string arg; input >> arg;)
+  {
+    args.push_back(arg);
+  }
+  // Decidido antes das opções para que o programa seja consumido mesmo em um pedido inválido
+  job.inlineProgram = !args.empty() && args.back() == "-";
+
+  CommandLineOptions options;
+  options.config = job.config;
+  for (const std::string &arg : args)
+  {
+    if (arg.rfind("--saida=", 0) == 0)
+    {
+      outputName = arg.substr(8);
+      continue;
+    }
+    if (!parseCommandLineOption(arg, options, error))
+    {
+      return false;
+    }
+    if (arg.rfind("--", 0) == 0 && !isServerRequestOption(arg))
+    {
+      error = "Opção não aceita em um pedido: " + arg;
+      return false;
+    }
+  }
+  if (options.files.size() != 1)
+  {
+    error = "o pedido deve ter um identificador e um arquivo de instruções (ou -)";
+    return false;
+  }
+  job.config = options.config;
+  job.engine = options.engine;
+  job.eventDriven = options.eventDriven;
+  job.statsFormat = options.statsFormat;
+  job.tracePath = job.inlineProgram ? "" : options.files[0];
+  const std::string &formatName = options.formatName;
+
+  if (!outputName.empty())
+  {
+    if (outputDir.empty())
+    {
+      error = "--saida exige que o servidor seja iniciado com --saidas=DIRETORIO";
+      return false;
+    }
+    if (outputName.find('/') != std::string::npos || outputName == "." || outputName == "..")
+    {
+      error = "--saida deve ser um nome de arquivo, sem diretório: " + outputName;
+      return false;
+    }
+    job.output = outputDir + "/" + outputName;
+  }
+  if (job.engine != EngineKind::Tomasulo && job.eventDriven)
+  {
+    error = "--eventos vale apenas para o motor tomasulo";
+    return false;
+  }
+  if (!formatName.empty() && job.output.empty())
+  {
+    error = "--formato exige --saida";
+    return false;
+  }
+  if (formatName == "texto" || (formatName.empty() && job.engine != EngineKind::Tomasulo))
+  {
+    job.format = OutputFormat::Text;
+  }
+  else if (formatName == "nenhum")
+  {
+    job.format = OutputFormat::None;
+  }
+  else if ((formatName.empty() || formatName == "delta") && job.engine == EngineKind::Tomasulo)
+  {
+    job.format = OutputFormat::Delta;
+  }
+  else
+  {
+    error = "formato inválido: " + formatName;
+    return false;
+  }
+  if (job.output.empty())
+  {
+    job.format = OutputFormat::None;
+  }
+  if (!validateConfig(job.config, error))
+  {
+    error = "configuração inválida: " + error;
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Simula um pedido e monta a resposta.
+ *
+ * @return Um objeto JSON em uma linha, com os ciclos, as instruções e o IPC (e os contadores de
+ * desempenho, se pedidos) ou o erro.
+ */
+inline std::string runServerJob(const ServerJob &job)
+{
+  std::string error;
+  std::istringstream programText(job.program);
+  std::unique_ptr<TraceSource> trace;
+  if (job.inlineProgram)
+  {
+    trace = std::make_unique<TraceReader>(programText, job.config.registerQnt);
+  }
+  else
+  {
+    trace = openTrace(job.tracePath, job.config.registerQnt, error);
+    if (!trace)
+    {
+      return serverError(job.id, error);
+    }
+  }
+
+  std::ofstream outputFile;
+  std::ostream discard(nullptr);
+  if (!job.output.empty())
+  {
+    // Um link simbólico no diretório de saída não pode levar a gravação para fora dele
+    struct stat info;
+    if (lstat(job.output.c_str(), &info) == 0 && !S_ISREG(info.st_mode))
+    {
+      return serverError(job.id, "o arquivo de saída existe e não é um arquivo comum");
+    }
+    outputFile.open(job.output, std::ios::binary);
+    if (!outputFile.is_open())
+    {
+      return serverError(job.id, "erro ao abrir o arquivo de saída");
+    }
+  }
+  std::ostream &output = job.output.empty() ? discard : outputFile;
+
+  std::unique_ptr<Engine> engine =
+      job.engine == EngineKind::Tomasulo
+          ? makeSimulator(*trace, output, job.format, job.eventDriven, job.config)
+          : makeEngine(job.engine, *trace, output, job.format, job.config);
+  engine->run();
+  if (!trace->error.empty())
+  {
+    return serverError(job.id, trace->error);
+  }
+  if (!job.output.empty() && !outputFile.flush())
+  {
+    return serverError(job.id, "erro ao gravar o arquivo de saída");
+  }
+
+  std::ostringstream response;
+  response << "{\"id\":" << jsonString(job.id) << ",\"ciclos\":" << engine->totalCycles()
+           << ",\"instrucoes\":" << engine->completedCount() << ",\"ipc\":" << engine->ipc();
+  if (!job.statsFormat.empty())
+  {
+    // O JSON entra como objeto; o resumo legível, como texto
+    bool json = job.statsFormat == "json";
+    std::ostringstream stats;
+    engine->writeStats(stats, json);
+    std::string text = stats.str();
+    text.erase(text.find_last_not_of('\n') + 1);
+    response << ",\"estatisticas\":" << (json ? text : jsonString(text));
+  }
+  response << "}";
+  return response.str();
+}
+
+/**
+ * @brief Destino das respostas de um cliente.
+ *
+ * As simulações de um cliente terminam em qualquer ordem, em threads diferentes; cada resposta é
+ * uma linha inteira, gravada sob o mutex. O descritor é fechado quando a última simulação pendente
+ * do cliente responde.
+ */
+class ServerConnection
+{
+public:
+  ServerConnection(int fd, bool owned)
+      : fd(fd), owned(owned), failed(false) {}
+
+  ~ServerConnection()
+  {
+    if (owned)
+    {
+      ::close(fd);
+    }
+  }
+
+  ServerConnection(const ServerConnection &) = delete;
+  ServerConnection &operator=(const ServerConnection &) = delete;
+
+  void send(const std::string &response)
+  {
+    std::string line = response + "\n";
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t sent = 0; sent < line.size() && !failed;)
+    {
+      ssize_t written = ::write(fd, line.data() + sent, line.size() - sent);
+      if (written < 0 && errno == EINTR)
+      {
+        continue;
+      }
+      // O cliente foi embora; as respostas seguintes são descartadas
+      failed = written <= 0;
+      sent += written > 0 ? static_cast<size_t>(written) : 0;
+    }
+  }
+
+  // Interrompe a leitura dos pedidos (encerramento do servidor)
+  void stopReading()
+  {
+    ::shutdown(fd, SHUT_RD);
+  }
+
+  int descriptor() const
+  {
+    return fd;
+  }
+
+private:
+  int fd;
+  bool owned; // Fecha o descritor na destruição (conexões do socket, não a saída padrão)
+  bool failed;
+  std::mutex mutex;
+};
+
+// Leitura de linhas de um descritor, sem o buffer do iostream (que não funciona com sockets)
+class LineReader
+{
+public:
+  explicit LineReader(int fd)
+      : fd(fd), start(0) {}
+
+  bool getline(std::string &line)
+  {
+    while (true)
+    {
+      size_t end = buffer.find('\n', start);
+      if (end != std::string::npos)
+      {
+        line.assign(buffer, start, end - start);
+        start = end + 1;
+        return true;
+      }
+      buffer.erase(0, start);
+      start = 0;
+      char chunk[65536];
+      ssize_t count = ::read(fd, chunk, sizeof(chunk));
+      if (count < 0 && errno == EINTR)
+      {
+        continue;
+      }
+      if (count <= 0)
+      {
+        // Última linha sem '\n'
+        line = buffer;
+        buffer.clear();
+        return !line.empty();
+      }
+      buffer.append(chunk, static_cast<size_t>(count));
+    }
+  }
+
+private:
+  int fd;
+  std::string buffer;
+  size_t start; // Início da próxima linha em `buffer`
+};
+
+/**
+ * @brief Lê os pedidos de um cliente e os envia para o conjunto de threads.
+ *
+ * Linhas vazias e iniciadas por '#' são ignoradas. As respostas voltam pela conexão conforme as
+ * simulações terminam, não necessariamente na ordem dos pedidos.
+ *
+ * @return true se o cliente pediu o encerramento do servidor ("encerrar").
+ */
+inline bool serveClient(int input, const std::shared_ptr<ServerConnection> &connection, WorkStealingPool &pool,
+                        const SchedulerConfig &base, const std::string &outputDir)
+{
+  LineReader reader(input);
+  std::string line;
+  while (reader.getline(line))
+  {
+    line.erase(line.find_last_not_of(" \t\r") + 1);
+    size_t first = line.find_first_not_of(" \t");
+    if (first == std::string::npos || line[first] == '#')
+    {
+      continue;
+    }
+    if (line.compare(first, std::string::npos, "encerrar") == 0)
+    {
+      return true;
+    }
+
+    ServerJob job;
+    job.config = base;
+    std::string error;
+    bool valid = parseServerRequest(line, outputDir, job, error);
+
+    // O programa enviado no pedido é consumido mesmo que o pedido seja inválido
+    if (job.inlineProgram)
+    {
+      std::string instruction;
+      bool ended = false;
+      while (!ended && reader.getline(instruction))
+      {
+        instruction.erase(instruction.find_last_not_of(" \t\r") + 1);
+        ended = instruction == SERVER_PROGRAM_END;
+        if (!ended)
+        {
+          job.program += instruction;
+          job.program += '\n';
+        }
+      }
+      if (!ended && valid)
+      {
+        valid = false;
+        error = "programa sem a linha final \".\"";
+      }
+    }
+
+    if (!valid)
+    {
+      connection->send(serverError(job.id, error));
+      continue;
+    }
+    pool.submit([connection, job = std::move(job)]()
+                { connection->send(runServerJob(job)); });
+  }
+  return false;
+}
+
+/**
+ * @brief Servidor de simulações: atende pedidos até o fim da entrada ou até "encerrar".
+ *
+ * Sem socket, lê os pedidos da entrada padrão e responde na saída padrão, um por linha. Com um
+ * caminho, atende clientes em um socket Unix com o mesmo protocolo, cada um em uma thread de leitura
+ * própria; "encerrar", de qualquer cliente, para de aceitar conexões e de ler pedidos, e o servidor
+ * termina depois de responder os pedidos já recebidos. Em ambos os casos as simulações rodam no
+ * mesmo conjunto de threads.
+ *
+ * @param socketPath Caminho do socket Unix ou vazio para a entrada e a saída padrão.
+ * @param base Configuração usada pelos pedidos, alterada pelas opções --config de cada um.
+ * @param outputDir Único diretório em que os pedidos podem gravar (--saida); vazio: nenhum.
+ * @return false se o diretório de saída não existe ou o socket não pôde ser criado.
+ */
+inline bool runServer(const std::string &socketPath, const SchedulerConfig &base, const std::string &outputDir,
+                      unsigned threads, std::string &error)
+{
+  struct stat info;
+  if (!outputDir.empty() && (::stat(outputDir.c_str(), &info) != 0 || !S_ISDIR(info.st_mode)))
+  {
+    error = "diretório de saída inexistente: " + outputDir;
+    return false;
+  }
+
+  // Um cliente que fecha a conexão antes da resposta não derruba o servidor
+  std::signal(SIGPIPE, SIG_IGN);
+  WorkStealingPool pool(threads);
+
+  if (socketPath.empty())
+  {
+    auto connection = std::make_shared<ServerConnection>(STDOUT_FILENO, false);
+    serveClient(STDIN_FILENO, connection, pool, base, outputDir);
+    pool.wait();
+    return true;
+  }
+
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  if (socketPath.size() >= sizeof(address.sun_path))
+  {
+    error = "caminho do socket muito longo: " + socketPath;
+    return false;
+  }
+  std::strcpy(address.sun_path, socketPath.c_str());
+
+  // Um socket deixado por um servidor anterior é substituído; outros arquivos não
+  if (lstat(socketPath.c_str(), &info) == 0 && S_ISSOCK(info.st_mode))
+  {
+    ::unlink(socketPath.c_str());
+  }
+  int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listener < 0 || ::bind(listener, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 ||
+      ::listen(listener, SOMAXCONN) != 0)
+  {
+    error = "erro ao criar o socket '" + socketPath + "': " + std::strerror(errno);
+    if (listener >= 0)
+    {
+      ::close(listener);
+    }
+    return false;
+  }
+
+  // As threads de leitura usam as variáveis locais e são todas unidas antes de runServer retornar
+  std::mutex mutex;
+  std::set<std::shared_ptr<ServerConnection>> reading; // Clientes com a thread de leitura ativa
+  std::vector<std::thread> clients;                    // Threads de leitura ainda não unidas
+  std::vector<std::thread::id> finished;               // Threads de leitura que já terminaram
+  std::atomic<bool> stopping(false);
+
+  // Une as threads de clientes que já desconectaram, para que não se acumulem
+  auto joinFinished = [&]()
+  {
+    std::vector<std::thread::id> done;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      done.swap(finished);
+    }
+    for (std::thread::id id : done)
+    {
+      auto client = std::find_if(clients.begin(), clients.end(), [id](const std::thread &thread)
+                                 { return thread.get_id() == id; });
+      client->join();
+      clients.erase(client);
+    }
+  };
+
+  while (!stopping)
+  {
+    int client = ::accept(listener, nullptr, nullptr);
+    if (client < 0)
+    {
+      if (errno == EINTR || errno == ECONNABORTED)
+      {
+        continue;
+      }
+      break;
+    }
+    joinFinished();
+    auto connection = std::make_shared<ServerConnection>(client, true);
+    std::lock_guard<std::mutex> lock(mutex);
+    if (stopping)
+    {
+      break;
+    }
+    reading.insert(connection);
+    clients.emplace_back([&, connection]()
+                         {
+                           bool shutdown = serveClient(connection->descriptor(), connection, pool, base, outputDir);
+                           std::lock_guard<std::mutex> guard(mutex);
+                           reading.erase(connection);
+                           finished.push_back(std::this_thread::get_id());
+                           if (shutdown && !stopping.exchange(true))
+                           {
+                             // Acorda o accept() e as threads de leitura dos outros clientes
+                             ::shutdown(listener, SHUT_RDWR);
+                             for (const auto &other : reading)
+                             {
+                               other->stopReading();
+                             }
+                           } });
+  }
+
+  for (auto &thread : clients)
+  {
+    thread.join();
+  }
+  pool.wait();
+  ::close(listener);
+  ::unlink(socketPath.c_str());
+  return true;
+}
+
+#endif
@@ -0,0 +1,151 @@
+#ifndef TOMASULO_SIMULATOR_HPP
+#define TOMASULO_SIMULATOR_HPP
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "checkpoint.hpp"
+#include "machine.hpp"
+#include "scheduler.hpp"
+
+/**
+ * @brief Motor de escalonamento: simula um programa ciclo a ciclo e informa o desempenho.
+ *
+ * O algoritmo de Tomasulo (Simulator) é um dos motores; os motores de referência de engines.hpp
+ * (placar e pipeline em ordem) usam a mesma fonte de instruções e a mesma configuração de unidades.
+ */
+class Engine
+{
+public:
+  virtual ~Engine() = default;
+
+  virtual bool step() = 0;
+  virtual bool runUntil(int lastCycle) = 0;
+  virtual void run() = 0;
+  virtual void finish() = 0;
+  virtual bool isExecutionComplete() const = 0;
+  virtual int cycle() const = 0;
+  virtual int totalCycles() const = 0;
+  virtual size_t completedCount() const = 0;
+  virtual double ipc() const = 0;
+  virtual void writeStats(std::ostream &out, bool json) const = 0;
+};
+
+/**
+ * @brief Interface comum aos simuladores configurados em tempo de execução e aos especializados.
+ *
+ * As chamadas virtuais acontecem apenas na fronteira (um ciclo, um trecho ou a simulação inteira);
+ * o laço de cada implementação continua sendo o do BasicScheduler correspondente.
+ */
+class Simulator : public Engine
+{
+public:
+  virtual bool resume() = 0;
+  virtual bool saveCheckpoint(const std::string &path, std::string &error) const = 0;
+  virtual bool restore(const Checkpoint &checkpoint, std::string &error) = 0;
+
+  // Passa a usar a memória de dados, a L2 e o barramento compartilhados com outros núcleos
+  virtual void shareMemory(MemoryPort &port) = 0;
+};
+
+// Implementação da interface por um BasicScheduler
+template <typename SchedulerType>
+class SimulatorModel final : public Simulator
+{
+public:
+  SchedulerType scheduler;
+
+  template <typename... Args>
+  explicit SimulatorModel(Args &&...args)
+      : scheduler(std::forward<Args>(args)...) {}
+
+  bool step() override
+  {
+    return scheduler.step();
+  }
+
+  bool runUntil(int lastCycle) override
+  {
+    return scheduler.runUntil(lastCycle);
+  }
+
+  void run() override
+  {
+    scheduler.run();
+  }
+
+  void finish() override
+  {
+    scheduler.finish();
+  }
+
+  bool resume() override
+  {
+    return scheduler.resume();
+  }
+
+  bool isExecutionComplete() const override
+  {
+    return scheduler.isExecutionComplete();
+  }
+
+  int cycle() const override
+  {
+    return scheduler.cycle;
+  }
+
+  int totalCycles() const override
+  {
+    return scheduler.totalCycles();
+  }
+
+  size_t completedCount() const override
+  {
+    return scheduler.completedCount;
+  }
+
+  double ipc() const override
+  {
+    return scheduler.ipc();
+  }
+
+  void writeStats(std::ostream &out, bool json) const override
+  {
+    scheduler.writeStats(out, json);
+  }
+
+  bool saveCheckpoint(const std::string &path, std::string &error) const override
+  {
+    return ::saveCheckpoint(scheduler, path, error);
+  }
+
+  bool restore(const Checkpoint &checkpoint, std::string &error) override
+  {
+    return checkpoint.restore(scheduler, error);
+  }
+
+  void shareMemory(MemoryPort &port) override
+  {
+    scheduler.sharedMemory = &port;
+  }
+};
+
+/**
+ * @brief Cria o simulador para a configuração.
+ *
+ * A configuração de produção usa o ProductionScheduler, especializado em tempo de compilação; as
+ * demais usam o Scheduler configurado em tempo de execução. Os resultados são os mesmos.
+ */
+inline std::unique_ptr<Simulator> makeSimulator(TraceSource &trace, std::ostream &outputFile, OutputFormat format,
+                                                bool eventDriven, const SchedulerConfig &config)
+{
+  if (config == PRODUCTION_CONFIG)
+  {
+    return std::make_unique<SimulatorModel<ProductionScheduler>>(trace, outputFile, format, eventDriven, config);
+  }
+  return std::make_unique<SimulatorModel<Scheduler>>(trace, outputFile, format, eventDriven, config);
+}
+
+#endif
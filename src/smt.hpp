@@ -0,0 +1,316 @@
+#ifndef TOMASULO_SMT_HPP
+#define TOMASULO_SMT_HPP
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "batch.hpp"
+#include "config.hpp"
+#include "scheduler.hpp"
+#include "state.hpp"
+#include "tracefile.hpp"
+
+// Ordem em que as threads SMT disputam emissão, unidades funcionais e CDB a cada ciclo
+enum class FetchPolicy
+{
+  RoundRobin, // Rodízio: a thread com prioridade muda a cada ciclo
+  ICount      // ICOUNT: primeiro a thread com menos instruções esperando nas estações de reserva
+};
+
+const char *const FETCH_POLICY_NAMES[] = {"rodizio", "icount"};
+
+inline bool parseFetchPolicy(const std::string &name, FetchPolicy &policy)
+{
+  for (int i = 0; i < 2; i++)
+  {
+    if (name == FETCH_POLICY_NAMES[i])
+    {
+      policy = static_cast<FetchPolicy>(i);
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Núcleo com várias threads de hardware (SMT) que dividem as unidades funcionais.
+ *
+ * Cada thread é um Scheduler com os próprios registradores arquiteturais, renomeação, janela,
+ * estações de reserva, fila de loads e stores e memória de dados (programas independentes). As
+ * unidades funcionais de cada tipo, a largura de emissão (ISSUE_WIDTH) e o CDB (CDB_WIDTH) são do
+ * núcleo: a cada ciclo as threads são ordenadas pela política e, nessa ordem, despacham para as
+ * unidades livres, emitem até esgotar a largura de emissão e difundem resultados até esgotar o
+ * CDB. Todas as threads fazem um estágio antes de qualquer uma fazer o seguinte, então uma unidade
+ * liberada na escrita só é usada por outra thread no ciclo seguinte, como em um núcleo sem SMT.
+ */
+class SmtCore
+{
+public:
+  SchedulerConfig config;
+  FetchPolicy policy;
+  SharedUnits units[3];                          // Ocupação das unidades ADD, MUL e SW do núcleo
+  std::vector<std::unique_ptr<Scheduler>> threads;
+  int cycle;                                     // Ciclo atual do núcleo
+
+  SmtCore(const SchedulerConfig &config, FetchPolicy policy)
+      : config(config), policy(policy),
+        units{SharedUnits(config.addUnitQnt), SharedUnits(config.mulUnitQnt), SharedUnits(config.swUnitQnt)},
+        cycle(1) {}
+
+  // As threads guardam um ponteiro para `units`
+  SmtCore(const SmtCore &) = delete;
+  SmtCore &operator=(const SmtCore &) = delete;
+
+  // Acrescenta uma thread que lê as instruções de `trace` e grava o próprio estado em `out`
+  void addThread(TraceSource &trace, std::ostream &out, OutputFormat format)
+  {
+    threads.push_back(std::make_unique<Scheduler>(trace, out, format, false, config));
+    threads.back()->sharedUnits = units;
+  }
+
+  /**
+   * @brief Simula um ciclo do núcleo; threads que já terminaram ou travaram não participam.
+   *
+   * @return false se todas as threads terminaram (nenhum ciclo foi simulado).
+   */
+  bool step()
+  {
+    prioritize();
+    if (order.empty())
+    {
+      return false;
+    }
+    for (size_t t : order)
+    {
+      threads[t]->beginCycle();
+    }
+    for (size_t t : order)
+    {
+      threads[t]->dispatchReady();
+    }
+    size_t issueSlots = config.issueWidth;
+    for (size_t t : order)
+    {
+      issueSlots -= threads[t]->issueInstructions(issueSlots);
+    }
+    for (size_t t : order)
+    {
+      threads[t]->execute();
+    }
+    size_t cdbSlots = config.cdbWidth;
+    for (size_t t : order)
+    {
+      cdbSlots -= threads[t]->writeResults(cdbSlots);
+    }
+    // Uma thread parada pode esperar unidades ocupadas por outra; o núcleo só trava se todas pararem
+    bool stuck = std::all_of(order.begin(), order.end(), [this](size_t t)
+                             { return threads[t]->isDeadlocked(); });
+    for (size_t t : order)
+    {
+      threads[t]->endCycle();
+      if (stuck)
+      {
+        threads[t]->reportDeadlock();
+      }
+    }
+    cycle++;
+    return true;
+  }
+
+  // Simula até todas as threads terminarem e encerra os arquivos de saída
+  void run()
+  {
+    while (step())
+    {
+    }
+    for (auto &thread : threads)
+    {
+      thread->finish();
+    }
+  }
+
+  int totalCycles() const
+  {
+    return cycle - 1;
+  }
+
+  size_t completedCount() const
+  {
+    size_t total = 0;
+    for (const auto &thread : threads)
+    {
+      total += thread->completedCount;
+    }
+    return total;
+  }
+
+  double ipc() const
+  {
+    return totalCycles() > 0 ? static_cast<double>(completedCount()) / totalCycles() : 0.0;
+  }
+
+  // Fração da capacidade das unidades de um tipo usada pelas threads juntas
+  double utilization(UnitType type) const
+  {
+    std::uint64_t busy = 0;
+    size_t slots = 0;
+    for (const auto &thread : threads)
+    {
+      const UnitPool &pool = type == UnitType::Add ? thread->addUnits
+                             : type == UnitType::Mul ? thread->mulUnits
+                                                     : thread->swUnits;
+      for (std::uint64_t cycles : pool.busyCycles)
+      {
+        busy += cycles;
+      }
+      slots = pool.size();
+    }
+    return totalCycles() > 0 && slots > 0 ? static_cast<double>(busy) / (static_cast<double>(totalCycles()) * slots)
+                                          : 0.0;
+  }
+
+private:
+  std::vector<size_t> order; // Threads ainda em execução, na ordem de prioridade do ciclo atual
+
+  // Ordena as threads em execução; o rodízio também desempata o ICOUNT
+  void prioritize()
+  {
+    order.clear();
+    for (size_t i = 0; i < threads.size(); i++)
+    {
+      size_t t = (static_cast<size_t>(cycle - 1) + i) % threads.size();
+      if (!threads[t]->isExecutionComplete() && !threads[t]->deadlocked)
+      {
+        order.push_back(t);
+      }
+    }
+    if (policy == FetchPolicy::ICount)
+    {
+      std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b)
+                       { return waiting(*threads[a]) < waiting(*threads[b]); });
+    }
+  }
+
+  // Instruções emitidas e ainda não despachadas
+  static size_t waiting(const Scheduler &thread)
+  {
+    return thread.addStations.valid.count() + thread.mulStations.valid.count() + thread.swStations.valid.count();
+  }
+};
+
+// Escreve o resumo de cada thread e do núcleo
+inline void writeSmtSummary(std::ostream &out, const std::vector<BatchJob> &jobs, const SmtCore &core)
+{
+  for (size_t i = 0; i < jobs.size(); i++)
+  {
+    out << "Thread " << i << " (" << jobs[i].input << "): ";
+    if (!jobs[i].error.empty())
+    {
+      out << jobs[i].error << "\n";
+      continue;
+    }
+    out << jobs[i].cycles << " ciclos, " << jobs[i].instructions << " instruções, IPC " << jobs[i].ipc << "\n";
+  }
+  out << "Núcleo SMT (" << FETCH_POLICY_NAMES[static_cast<int>(core.policy)] << "): " << core.totalCycles()
+      << " ciclos, " << core.completedCount() << " instruções, IPC " << core.ipc() << "\n"
+      << "Utilização das unidades: " << std::fixed << std::setprecision(1)
+      << "ADD " << 100.0 * core.utilization(UnitType::Add) << "%, MUL " << 100.0 * core.utilization(UnitType::Mul)
+      << "%, SW " << 100.0 * core.utilization(UnitType::Sw) << "%\n"
+      << std::defaultfloat << std::setprecision(6);
+}
+
+// Escreve os contadores de cada thread, um objeto JSON por linha, seguidos dos totais do núcleo
+inline void writeSmtStatsJson(std::ostream &out, const SmtCore &core)
+{
+  for (size_t i = 0; i < core.threads.size(); i++)
+  {
+    std::ostringstream stats;
+    core.threads[i]->writeStats(stats, true);
+    std::string object = stats.str();
+    object.erase(object.find_last_not_of('\n') + 1);
+    out << "{\"thread\":" << i << ",\"estatisticas\":" << object << "}\n";
+  }
+  out << "{\"nucleo\":{\"politica\":\"" << FETCH_POLICY_NAMES[static_cast<int>(core.policy)]
+      << "\",\"ciclos\":" << core.totalCycles() << ",\"instrucoes\":" << core.completedCount()
+      << ",\"ipc\":" << core.ipc() << ",\"utilizacao\":{\"add\":" << core.utilization(UnitType::Add)
+      << ",\"mul\":" << core.utilization(UnitType::Mul) << ",\"sw\":" << core.utilization(UnitType::Sw) << "}}}\n";
+}
+
+/**
+ * @brief Simula os arquivos de instruções como threads de um único núcleo SMT.
+ *
+ * Cada thread grava o próprio arquivo de saída, como no modo em lote. Os ciclos de uma thread são
+ * os do núcleo até ela terminar.
+ *
+ * @param stats Formato das estatísticas de cada thread ("resumo", "json" ou vazio para nenhuma).
+ * @return Quantidade de threads com erro.
+ */
+inline size_t runSmt(std::vector<BatchJob> &jobs, OutputFormat format, const SchedulerConfig &config,
+                     FetchPolicy policy, const std::string &stats, std::ostream &summary)
+{
+  std::vector<std::unique_ptr<TraceSource>> traces(jobs.size());
+  std::vector<std::ofstream> outputs(jobs.size());
+  SmtCore core(config, policy);
+  for (size_t i = 0; i < jobs.size(); i++)
+  {
+    if (jobs[i].error.empty())
+    {
+      traces[i] = openTrace(jobs[i].input, config.registerQnt, jobs[i].error);
+    }
+    if (traces[i])
+    {
+      outputs[i].open(jobs[i].output, std::ios::binary);
+      if (!outputs[i].is_open())
+      {
+        jobs[i].error = "erro ao abrir o arquivo de saída";
+      }
+    }
+    if (!jobs[i].error.empty())
+    {
+      summary << jobs[i].input << ": " << jobs[i].error << "\n";
+      return 1;
+    }
+    core.addThread(*traces[i], outputs[i], format);
+  }
+
+  core.run();
+
+  size_t failed = 0;
+  for (size_t i = 0; i < jobs.size(); i++)
+  {
+    const Scheduler &thread = *core.threads[i];
+    jobs[i].error = traces[i]->error;
+    jobs[i].cycles = thread.totalCycles();
+    jobs[i].instructions = thread.completedCount;
+    jobs[i].ipc = thread.ipc();
+    failed += !jobs[i].error.empty();
+  }
+
+  if (stats == "json")
+  {
+    for (size_t i = 0; i < jobs.size(); i++)
+    {
+      if (!jobs[i].error.empty())
+      {
+        std::cerr << "Erro na thread " << i << " (" << jobs[i].input << "): " << jobs[i].error << std::endl;
+      }
+    }
+    writeSmtStatsJson(summary, core);
+    return failed;
+  }
+  writeSmtSummary(summary, jobs, core);
+  for (size_t i = 0; stats == "resumo" && i < jobs.size(); i++)
+  {
+    summary << "\n>> Thread " << i << "\n";
+    core.threads[i]->writeStats(summary, false);
+  }
+  return failed;
+}
+
+#endif
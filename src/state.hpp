@@ -0,0 +1,395 @@
+#ifndef TOMASULO_STATE_HPP
+#define TOMASULO_STATE_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "instruction.hpp"
+
+// Definindo a estrutura de uma instrução em execução
+class Operation
+{
+public:
+  Instruction inst; // Instrução decodificada
+  bool isIssued;    // Se a instrução foi emitida
+  bool isExecuting; // Se a instrução está em execução
+  bool isCompleted; // Se a instrução foi concluída
+  size_t seq;       // Posição da instrução no programa
+  size_t memSeq;    // Posição de lw/sw na fila de loads e stores
+
+  // Tags físicas obtidas pela RAT na emissão (NO_REGISTER quando não se aplica)
+  std::uint8_t physDest;
+  std::uint8_t physSrc[2];
+
+  Operation()
+      : Operation(Instruction{}) {}
+
+  Operation(const Instruction &inst)
+      : inst(inst), isIssued(false), isExecuting(false), isCompleted(false), seq(0), memSeq(0),
+        physDest(NO_REGISTER), physSrc{NO_REGISTER, NO_REGISTER} {}
+};
+
+// Conjunto de bits com tamanho definido na criação
+class BitSet
+{
+public:
+  BitSet(size_t size = 0)
+      : words((size + 63) / 64, 0), bits(size) {}
+
+  size_t size() const
+  {
+    return bits;
+  }
+
+  bool test(size_t i) const
+  {
+    return (words[i / 64] >> (i % 64)) & 1;
+  }
+
+  void set(size_t i)
+  {
+    words[i / 64] |= std::uint64_t(1) << (i % 64);
+  }
+
+  void reset(size_t i)
+  {
+    words[i / 64] &= ~(std::uint64_t(1) << (i % 64));
+  }
+
+  void assign(size_t i, bool value)
+  {
+    if (value)
+    {
+      set(i);
+    }
+    else
+    {
+      reset(i);
+    }
+  }
+
+  void clear()
+  {
+    for (std::uint64_t &word : words)
+    {
+      word = 0;
+    }
+  }
+
+  bool any() const
+  {
+    for (std::uint64_t word : words)
+    {
+      if (word != 0)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Desliga os bits ligados em other (this &= ~other)
+  void andNot(const BitSet &other)
+  {
+    for (size_t w = 0; w < words.size(); w++)
+    {
+      words[w] &= ~other.words[w];
+    }
+  }
+
+  // Atribui set & ~a & ~b
+  void assignDifference(const BitSet &set, const BitSet &a, const BitSet &b)
+  {
+    for (size_t w = 0; w < words.size(); w++)
+    {
+      words[w] = set.words[w] & ~a.words[w] & ~b.words[w];
+    }
+  }
+
+  // Indica se algum bit está ligado em set e em (a | b)
+  static bool intersects(const BitSet &set, const BitSet &a, const BitSet &b)
+  {
+    for (size_t w = 0; w < set.words.size(); w++)
+    {
+      if (set.words[w] & (a.words[w] | b.words[w]))
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Quantidade de bits ligados
+  size_t count() const
+  {
+    size_t total = 0;
+    for (std::uint64_t word : words)
+    {
+      total += __builtin_popcountll(word);
+    }
+    return total;
+  }
+
+  // Primeiro bit desligado ou size() se todos estiverem ligados
+  size_t findFirstClear() const
+  {
+    for (size_t w = 0; w < words.size(); w++)
+    {
+      if (~words[w] != 0)
+      {
+        size_t i = w * 64 + __builtin_ctzll(~words[w]);
+        return i < bits ? i : bits;
+      }
+    }
+    return bits;
+  }
+
+  // Chama f(i) para cada bit ligado, em ordem crescente; f pode alterar o conjunto
+  template <typename F>
+  void forEachSet(F f) const
+  {
+    for (size_t w = 0; w < words.size(); w++)
+    {
+      for (std::uint64_t word = words[w]; word != 0; word &= word - 1)
+      {
+        f(w * 64 + __builtin_ctzll(word));
+      }
+    }
+  }
+
+private:
+  std::vector<std::uint64_t> words;
+  size_t bits;
+};
+
+/**
+ * @brief Unidades funcionais de um tipo, guardadas em vetores paralelos indexados pela posição.
+ *
+ * Cada unidade tem `depth` posições, uma por instrução em voo: uma unidade pipelinizada aceita uma
+ * nova instrução a cada `initiationInterval` ciclos e mantém até latência / intervalo instruções
+ * executando ao mesmo tempo. A posição p pertence à unidade p / depth. Sem pipeline (intervalo
+ * igual à latência) há uma posição por unidade.
+ */
+class UnitPool
+{
+public:
+  UnitType type;                         // Tipo das unidades (ex: add, mul)
+  int latency;                           // Ciclos de latência das unidades
+  int initiationInterval;                // Ciclos entre despachos para a mesma unidade
+  int depth;                             // Posições (instruções em voo) por unidade
+  BitSet busy;                           // Posições ocupadas
+  std::vector<int> remaining;            // Ciclos restantes de execução em cada posição
+  std::vector<Operation *> instruction;  // Instrução em execução em cada posição
+  std::vector<std::uint64_t> busyCycles; // Ciclos em que cada posição esteve ocupada
+  std::vector<int> nextAccept;           // Primeiro ciclo em que cada unidade aceita outra instrução
+
+  UnitPool(UnitType type, int latency, int quant, int initiationInterval = 0)
+      : type(type), latency(latency), initiationInterval(initiationInterval > 0 ? initiationInterval : latency),
+        depth((latency + this->initiationInterval - 1) / this->initiationInterval), busy(quant * depth),
+        remaining(busy.size(), 0), instruction(busy.size(), nullptr), busyCycles(busy.size(), 0),
+        nextAccept(quant, 0) {}
+
+  // Quantidade de posições
+  size_t size() const
+  {
+    return busy.size();
+  }
+
+  // Quantidade de unidades
+  size_t unitCount() const
+  {
+    return nextAccept.size();
+  }
+
+  // Ciclos de posição ocupada somados entre as posições da unidade
+  std::uint64_t unitBusyCycles(size_t unit) const
+  {
+    std::uint64_t sum = 0;
+    for (size_t i = unit * depth; i < (unit + 1) * depth; i++)
+    {
+      sum += busyCycles[i];
+    }
+    return sum;
+  }
+};
+
+/**
+ * @brief Ocupação das unidades funcionais de um tipo divididas entre as threads de um núcleo SMT.
+ *
+ * Cada thread continua com o próprio UnitPool, que guarda as posições das suas instruções; aqui
+ * ficam as posições ocupadas de cada unidade somando todas as threads e o ciclo em que ela volta a
+ * aceitar, de modo que as threads juntas não usam mais unidades do que a configuração tem.
+ */
+struct SharedUnits
+{
+  std::vector<int> inUse;      // Posições ocupadas de cada unidade, somando as threads
+  std::vector<int> nextAccept; // Primeiro ciclo em que cada unidade aceita outra instrução
+
+  SharedUnits(int quant = 0)
+      : inUse(quant, 0), nextAccept(quant, 0) {}
+};
+
+/**
+ * @brief Estações de reserva de uma classe de unidades funcionais.
+ *
+ * Cada estação guarda uma instrução emitida até que ela seja despachada para uma unidade. Os
+ * operandos com escrita pendente são representados pelas tags Qj e Qk, que são os registradores
+ * físicos que ainda serão escritos. Para cada tag há um conjunto de bits com as estações que
+ * esperam por ela, então a difusão de um resultado no barramento comum (CDB) acorda todos os
+ * dependentes com algumas operações por palavra, sem percorrer as instruções.
+ */
+class ReservationStations
+{
+public:
+  BitSet valid;                       // Estações ocupadas
+  BitSet pendingJ;                    // Estações esperando o primeiro operando (Qj)
+  BitSet pendingK;                    // Estações esperando o segundo operando (Qk)
+  BitSet ready;                       // Estações com os dois operandos disponíveis (calculado na seleção)
+  std::vector<Operation *> operation; // Instrução em cada estação
+  std::vector<std::uint8_t> qj;       // Tag do primeiro operando ou NO_REGISTER
+  std::vector<std::uint8_t> qk;       // Tag do segundo operando ou NO_REGISTER
+  std::vector<BitSet> consumersJ;     // Estações cujo Qj é cada tag
+  std::vector<BitSet> consumersK;     // Estações cujo Qk é cada tag
+
+  ReservationStations(int quant, size_t tagQnt)
+      : valid(quant), pendingJ(quant), pendingK(quant), ready(quant), operation(quant, nullptr),
+        qj(quant, NO_REGISTER), qk(quant, NO_REGISTER), consumersJ(tagQnt, BitSet(quant)),
+        consumersK(tagQnt, BitSet(quant)) {}
+
+  size_t size() const
+  {
+    return valid.size();
+  }
+
+  // Índice de uma estação livre ou size() se todas estiverem ocupadas
+  size_t findFree() const
+  {
+    return valid.findFirstClear();
+  }
+
+  // Ocupa a estação com a instrução; tags iguais a NO_REGISTER indicam operandos disponíveis
+  void reserve(size_t i, Operation *op, std::uint8_t tagJ, std::uint8_t tagK)
+  {
+    valid.set(i);
+    operation[i] = op;
+    qj[i] = tagJ;
+    qk[i] = tagK;
+    if (tagJ != NO_REGISTER)
+    {
+      pendingJ.set(i);
+      consumersJ[tagJ].set(i);
+    }
+    if (tagK != NO_REGISTER)
+    {
+      pendingK.set(i);
+      consumersK[tagK].set(i);
+    }
+  }
+
+  // Libera a estação quando a instrução é despachada
+  void release(size_t i)
+  {
+    valid.reset(i);
+    operation[i] = nullptr;
+  }
+
+  // Difusão no CDB: o valor da tag ficou disponível para todas as estações que esperavam por ele
+  void wakeup(std::uint8_t tag)
+  {
+    pendingJ.andNot(consumersJ[tag]);
+    pendingK.andNot(consumersK[tag]);
+    consumersJ[tag].clear();
+    consumersK[tag].clear();
+  }
+
+  // Recalcula as estações prontas para despacho
+  void updateReady()
+  {
+    ready.assignDifference(valid, pendingJ, pendingK);
+  }
+
+  // Indica se alguma estação ocupada ainda espera um operando
+  bool hasWaiting() const
+  {
+    return BitSet::intersects(valid, pendingJ, pendingK);
+  }
+};
+
+// Registradores físicos guardados em vetores paralelos indexados pelo registrador
+class RegisterFile
+{
+public:
+  std::vector<std::string> names;       // Nome de cada registrador, usado apenas nos relatórios
+  std::vector<int> value;               // Valor atual de cada registrador
+  std::vector<int> readers;             // Instruções emitidas que ainda vão ler cada registrador
+  BitSet writing;                       // Registradores com escrita pendente
+  BitSet busy;                          // Registradores com leitores ou escrita pendentes
+  std::vector<Operation *> instruction; // Instrução que está utilizando cada registrador
+
+  // Cria os registradores arquiteturais (F e R) seguidos dos temporários de renomeação
+  RegisterFile(int registerQnt, int renameRegisterQnt, int initialValue)
+      : value(2 * registerQnt + renameRegisterQnt, initialValue), readers(value.size(), 0), writing(value.size()),
+        busy(value.size()), instruction(value.size(), nullptr)
+  {
+    for (size_t i = 0; i < value.size(); i++)
+    {
+      names.push_back(registerName(static_cast<std::uint8_t>(i), registerQnt));
+    }
+  }
+
+  size_t size() const
+  {
+    return value.size();
+  }
+
+  bool isBusy(size_t i) const
+  {
+    return busy.test(i);
+  }
+
+  bool isWriting(size_t i) const
+  {
+    return writing.test(i);
+  }
+
+  void addReader(size_t i)
+  {
+    readers[i]++;
+    busy.set(i);
+  }
+
+  void removeReader(size_t i)
+  {
+    readers[i]--;
+    updateBusy(i);
+  }
+
+  void setReaders(size_t i, int count)
+  {
+    readers[i] = count;
+    updateBusy(i);
+  }
+
+  void setWriting(size_t i, bool pending)
+  {
+    writing.assign(i, pending);
+    updateBusy(i);
+  }
+
+private:
+  void updateBusy(size_t i)
+  {
+    busy.assign(i, readers[i] > 0 || writing.test(i));
+  }
+};
+
+// Cópia da tabela de renomeação, usada para salvar e restaurar o estado de renomeação
+struct RatCheckpoint
+{
+  std::vector<std::uint8_t> rat;      // Registrador físico de cada registrador arquitetural
+  std::vector<std::uint8_t> aliasOf;  // Registrador arquitetural de cada temporário alocado
+  std::vector<std::uint8_t> freeList; // Temporários livres
+};
+
+#endif
@@ -0,0 +1,242 @@
+#ifndef TOMASULO_STATS_HPP
+#define TOMASULO_STATS_HPP
+
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "memory.hpp"
+#include "state.hpp"
+
+// Causas de ciclos perdidos
+enum class StallCause : std::uint8_t
+{
+  Structural,    // Instrução pronta sem unidade funcional livre do seu tipo
+  Raw,           // Instrução em estação de reserva esperando um operando (Qj/Qk)
+  RenameFailure, // Emissão parada por falta de temporário livre
+  WindowFull,    // Emissão parada porque a janela está cheia
+  StationFull,   // Emissão parada sem estação de reserva livre na classe da instrução
+  Cdb,           // Resultado pronto esperando vaga no barramento comum
+  MemoryOrder,   // lw pronto esperando um sw anterior (endereço desconhecido ou dado não capturado)
+  LsqFull        // Emissão de lw/sw parada porque a fila de loads e stores está cheia
+};
+
+const int STALL_CAUSE_QNT = 8;
+
+// Nomes usados no JSON e descrições usadas no resumo, indexados por StallCause
+const char *const STALL_NAMES[STALL_CAUSE_QNT] = {"estrutural", "raw", "falha_renomeacao", "janela_cheia",
+                                                      "estacoes_cheias", "cdb", "ordem_memoria", "lsq_cheia"};
+const char *const STALL_DESCRIPTIONS[STALL_CAUSE_QNT] = {
+    "Estrutural (sem unidade livre)",
+    "Dependência verdadeira (RAW)",
+    "Falha de renomeação (sem temporário)",
+    "Janela cheia",
+    "Estações de reserva cheias",
+    "Barramento comum (CDB) ocupado",
+    "Ordem de memória (sw anterior)",
+    "Fila de loads e stores cheia",
+};
+
+/**
+ * @brief Contadores de desempenho da simulação.
+ *
+ * Um ciclo conta como parado por uma causa se ela ocorreu pelo menos uma vez no ciclo (uma
+ * instrução pode esperar por causas diferentes em ciclos diferentes, e várias causas podem ocorrer
+ * no mesmo ciclo). Os ciclos pulados no modo dirigido a eventos repetem a amostra do último ciclo
+ * simulado, pois nenhum estado muda neles.
+ */
+struct SchedulerStats
+{
+  std::uint64_t stallCycles[STALL_CAUSE_QNT] = {}; // Ciclos com cada causa de parada
+  std::uint64_t warRenames = 0;                    // Renomeações por destino com leitores pendentes
+  std::uint64_t wawRenames = 0;                    // Renomeações por destino com escrita pendente
+  std::uint64_t forwardedLoads = 0;                // lw atendidos por um sw anterior na fila
+  std::uint64_t busyRegisterSum = 0;               // Soma, por ciclo, dos registradores físicos em uso
+  int busyRegisterPeak = 0;                        // Máximo de registradores físicos em uso
+  std::vector<std::uint64_t> tempHistogram;        // Ciclos com k temporários alocados, indexado por k
+
+  // Amostra do ciclo atual
+  bool cycleStall[STALL_CAUSE_QNT] = {};
+  int cycleBusyRegisters = 0;
+  int cycleTempRegisters = 0;
+
+  void beginCycle()
+  {
+    for (bool &stall : cycleStall)
+    {
+      stall = false;
+    }
+  }
+
+  void stall(StallCause cause)
+  {
+    cycleStall[static_cast<int>(cause)] = true;
+  }
+
+  // Encerra o ciclo com a ocupação de registradores observada ao final dele
+  void endCycle(int busyRegisters, int tempRegisters)
+  {
+    cycleBusyRegisters = busyRegisters;
+    cycleTempRegisters = tempRegisters;
+    if (busyRegisters > busyRegisterPeak)
+    {
+      busyRegisterPeak = busyRegisters;
+    }
+    if (static_cast<size_t>(tempRegisters) >= tempHistogram.size())
+    {
+      tempHistogram.resize(tempRegisters + 1, 0);
+    }
+    repeatCycle(1);
+  }
+
+  // Contabiliza a amostra do último ciclo para mais `count` ciclos
+  void repeatCycle(int count)
+  {
+    for (int i = 0; i < STALL_CAUSE_QNT; i++)
+    {
+      stallCycles[i] += cycleStall[i] ? count : 0;
+    }
+    busyRegisterSum += static_cast<std::uint64_t>(cycleBusyRegisters) * count;
+    tempHistogram[cycleTempRegisters] += count;
+  }
+
+  // Pico de temporários alocados
+  int tempRegisterPeak() const
+  {
+    for (size_t k = tempHistogram.size(); k > 0; k--)
+    {
+      if (tempHistogram[k - 1] > 0)
+      {
+        return static_cast<int>(k - 1);
+      }
+    }
+    return 0;
+  }
+
+  // Média de temporários alocados por ciclo
+  double tempRegisterMean(int cycles) const
+  {
+    std::uint64_t sum = 0;
+    for (size_t k = 0; k < tempHistogram.size(); k++)
+    {
+      sum += k * tempHistogram[k];
+    }
+    return cycles > 0 ? static_cast<double>(sum) / cycles : 0.0;
+  }
+};
+
+// Conjunto de unidades funcionais com o nome usado nos relatórios
+struct UnitGroup
+{
+  const char *name;
+  const UnitPool *units;
+};
+
+// Escreve o rótulo de uma linha do resumo, alinhando o valor pela quantidade de caracteres UTF-8
+inline std::ostream &writeLabel(std::ostream &out, const std::string &label)
+{
+  int width = 0;
+  for (unsigned char c : label)
+  {
+    width += (c & 0xC0) != 0x80;
+  }
+  return out << label << std::string(width < 40 ? 40 - width : 1, ' ');
+}
+
+// Fração da capacidade da unidade usada: ciclos ocupados de cada estágio do pipeline sobre o total
+inline double unitUtilization(const UnitPool &units, size_t unit, int cycles)
+{
+  return cycles > 0 ? static_cast<double>(units.unitBusyCycles(unit)) / (static_cast<double>(cycles) * units.depth)
+                    : 0.0;
+}
+
+/**
+ * @brief Escreve o resumo legível dos contadores de desempenho.
+ *
+ * @param out Destino do resumo.
+ * @param stats Contadores da simulação.
+ * @param cycles Total de ciclos simulados.
+ * @param instructions Instruções concluídas.
+ * @param groups Unidades funcionais por tipo.
+ * @param memory Caches, com os acertos e faltas de cada nível.
+ */
+inline void writeStatsSummary(std::ostream &out, const SchedulerStats &stats, int cycles, size_t instructions,
+                              const std::vector<UnitGroup> &groups, const MemoryHierarchy &memory)
+{
+  out << "> Estatísticas\n" << std::fixed;
+  writeLabel(out, "Ciclos") << cycles << "\n";
+  writeLabel(out, "Instruções concluídas") << instructions << "\n";
+  writeLabel(out, "IPC") << std::setprecision(3) << (cycles > 0 ? static_cast<double>(instructions) / cycles : 0.0) << "\n";
+
+  out << "\n> Ocupação das unidades funcionais\n";
+  for (const auto &group : groups)
+  {
+    for (size_t i = 0; i < group.units->unitCount(); i++)
+    {
+      writeLabel(out, std::string(group.name) + " " + std::to_string(i)) << group.units->unitBusyCycles(i) << " ciclos ("
+          << std::setprecision(1) << 100.0 * unitUtilization(*group.units, i, cycles) << "%)\n";
+    }
+  }
+
+  out << "\n> Ciclos parados por causa\n";
+  for (int i = 0; i < STALL_CAUSE_QNT; i++)
+  {
+    writeLabel(out, STALL_DESCRIPTIONS[i]) << stats.stallCycles[i] << "\n";
+  }
+
+  out << "\n> Renomeações (dependências falsas)\n";
+  writeLabel(out, "WAR") << stats.warRenames << "\n";
+  writeLabel(out, "WAW") << stats.wawRenames << "\n";
+
+  out << "\n> Pressão de registradores\n" << std::setprecision(2);
+  writeLabel(out, "Registradores em uso (média)") << (cycles > 0 ? static_cast<double>(stats.busyRegisterSum) / cycles : 0.0) << "\n";
+  writeLabel(out, "Registradores em uso (pico)") << stats.busyRegisterPeak << "\n";
+  writeLabel(out, "Temporários alocados (média)") << stats.tempRegisterMean(cycles) << "\n";
+  writeLabel(out, "Temporários alocados (pico)") << stats.tempRegisterPeak() << "\n";
+
+  out << "\n> Memória\n";
+  writeLabel(out, "L1 (acertos / faltas)") << memory.l1.hits << " / " << memory.l1.misses << "\n";
+  writeLabel(out, "L2 (acertos / faltas)") << memory.l2.hits << " / " << memory.l2.misses << "\n";
+  writeLabel(out, "lw encaminhados de sw") << stats.forwardedLoads << "\n";
+  out << std::defaultfloat << std::setprecision(6);
+}
+
+// Escreve os contadores de desempenho como um objeto JSON em uma linha
+inline void writeStatsJson(std::ostream &out, const SchedulerStats &stats, int cycles, size_t instructions,
+                           const std::vector<UnitGroup> &groups, const MemoryHierarchy &memory)
+{
+  out << "{\"ciclos\":" << cycles << ",\"instrucoes\":" << instructions
+      << ",\"ipc\":" << (cycles > 0 ? static_cast<double>(instructions) / cycles : 0.0) << ",\"unidades\":{";
+  for (size_t g = 0; g < groups.size(); g++)
+  {
+    out << (g ? "," : "") << "\"" << groups[g].name << "\":[";
+    for (size_t i = 0; i < groups[g].units->unitCount(); i++)
+    {
+      out << (i ? "," : "") << "{\"ocupada\":" << groups[g].units->unitBusyCycles(i)
+          << ",\"utilizacao\":" << unitUtilization(*groups[g].units, i, cycles) << "}";
+    }
+    out << "]";
+  }
+  out << "},\"paradas\":{";
+  for (int i = 0; i < STALL_CAUSE_QNT; i++)
+  {
+    out << (i ? "," : "") << "\"" << STALL_NAMES[i] << "\":" << stats.stallCycles[i];
+  }
+  out << "},\"renomeacoes\":{\"war\":" << stats.warRenames << ",\"waw\":" << stats.wawRenames << "}"
+      << ",\"registradores\":{\"media_em_uso\":"
+      << (cycles > 0 ? static_cast<double>(stats.busyRegisterSum) / cycles : 0.0)
+      << ",\"pico_em_uso\":" << stats.busyRegisterPeak
+      << ",\"media_temporarios\":" << stats.tempRegisterMean(cycles)
+      << ",\"pico_temporarios\":" << stats.tempRegisterPeak() << ",\"histograma_temporarios\":[";
+  for (size_t k = 0; k < stats.tempHistogram.size(); k++)
+  {
+    out << (k ? "," : "") << stats.tempHistogram[k];
+  }
+  out << "]},\"memoria\":{\"l1\":{\"acertos\":" << memory.l1.hits << ",\"faltas\":" << memory.l1.misses
+      << "},\"l2\":{\"acertos\":" << memory.l2.hits << ",\"faltas\":" << memory.l2.misses
+      << "},\"lw_encaminhados\":" << stats.forwardedLoads << "}}\n";
+}
+
+#endif
@@ -0,0 +1,261 @@
+#ifndef TOMASULO_SWEEP_HPP
+#define TOMASULO_SWEEP_HPP
+
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "config.hpp"
+#include "report.hpp"
+#include "scheduler.hpp"
+#include "thread_pool.hpp"
+#include "tracefile.hpp"
+
+// Intervalo de valores de um parâmetro na exploração do espaço de projeto
+struct SweepRange
+{
+  const ConfigParameter *param;
+  int first;
+  int last;
+  int step;
+};
+
+// Formato das linhas de resultado da exploração
+enum class SweepFormat : std::uint8_t
+{
+  Csv,
+  Json // Um objeto JSON por linha
+};
+
+// Resultado da simulação de uma configuração
+struct SweepResult
+{
+  SchedulerConfig config;
+  std::string error; // Vazio se a simulação aconteceu
+  int cycles;
+  size_t instructions;
+  double ipc;
+};
+
+// Converte um inteiro com sinal; retorna false se o texto não for um número
+inline bool parseInt(const std::string &text, int &value)
+{
+  try
+  {
+    size_t used = 0;
+    value = std::stoi(text, &used);
+    return used == text.size();
+  }
+  catch (const std::exception &)
+  {
+    return false;
+  }
+}
+
+// Interpreta "NOME=valor" e altera o parâmetro correspondente da configuração
+inline bool parseConfigAssignment(const std::string &spec, SchedulerConfig &config, std::string &error)
+{
+  size_t eq = spec.find('=');
+  const ConfigParameter *param = eq == std::string::npos ? nullptr : findConfigParameter(spec.substr(0, eq));
+  int value;
+  if (!param)
+  {
+    error = "parâmetro desconhecido em '" + spec + "'";
+    return false;
+  }
+  if (!parseInt(spec.substr(eq + 1), value))
+  {
+    error = "valor inválido em '" + spec + "'";
+    return false;
+  }
+  config.*param->field = value;
+  return true;
+}
+
+// Interpreta "NOME=inicio:fim[:passo]"
+inline bool parseSweepRange(const std::string &spec, SweepRange &range, std::string &error)
+{
+  size_t eq = spec.find('=');
+  range.param = eq == std::string::npos ? nullptr : findConfigParameter(spec.substr(0, eq));
+  if (!range.param)
+  {
+    error = "parâmetro desconhecido em '" + spec + "'";
+    return false;
+  }
+
+  std::vector<std::string> parts;
+  std::string values = spec.substr(eq + 1);
+  size_t start = 0;
+  for (size_t colon = values.find(':'); colon != std::string::npos; colon = values.find(':', start))
+  {
+    parts.push_back(values.substr(start, colon - start));
+    start = colon + 1;
+  }
+  parts.push_back(values.substr(start));
+
+  range.step = 1;
+  if (parts.size() < 2 || parts.size() > 3 || !parseInt(parts[0], range.first) || !parseInt(parts[1], range.last) ||
+      (parts.size() == 3 && !parseInt(parts[2], range.step)) || range.step <= 0 || range.last < range.first)
+  {
+    error = "intervalo inválido em '" + spec + "' (use NOME=inicio:fim[:passo])";
+    return false;
+  }
+  return true;
+}
+
+// Gera todas as combinações dos intervalos a partir da configuração base
+inline std::vector<SchedulerConfig> expandSweep(const SchedulerConfig &base, const std::vector<SweepRange> &ranges)
+{
+  std::vector<SchedulerConfig> configs{base};
+  for (const auto &range : ranges)
+  {
+    std::vector<SchedulerConfig> expanded;
+    for (const auto &config : configs)
+    {
+      // O próximo valor é conferido em 64 bits: somar o passo em int estouraria perto de INT_MAX
+      for (int value = range.first;; value += range.step)
+      {
+        expanded.push_back(config);
+        expanded.back().*range.param->field = value;
+        if (static_cast<long long>(value) + range.step > range.last)
+        {
+          break;
+        }
+      }
+    }
+    configs.swap(expanded);
+  }
+  return configs;
+}
+
+inline void writeSweepHeader(std::ostream &out, SweepFormat format)
+{
+  if (format != SweepFormat::Csv)
+  {
+    return;
+  }
+  for (const auto &param : CONFIG_PARAMETERS)
+  {
+    out << param.name << ",";
+  }
+  out << "ciclos,instrucoes,ipc,erro\n";
+}
+
+inline void writeSweepRow(std::ostream &out, SweepFormat format, const SweepResult &result)
+{
+  if (format == SweepFormat::Csv)
+  {
+    for (const auto &param : CONFIG_PARAMETERS)
+    {
+      out << result.config.*param.field << ",";
+    }
+    if (result.error.empty())
+    {
+      out << result.cycles << "," << result.instructions << "," << result.ipc << ",\n";
+    }
+    else
+    {
+      out << ",,," << csvString(result.error) << "\n";
+    }
+    return;
+  }
+
+  out << "{";
+  for (const auto &param : CONFIG_PARAMETERS)
+  {
+    out << "\"" << param.name << "\":" << result.config.*param.field << ",";
+  }
+  if (result.error.empty())
+  {
+    out << "\"ciclos\":" << result.cycles << ",\"instrucoes\":" << result.instructions << ",\"ipc\":" << result.ipc << "}\n";
+  }
+  else
+  {
+    out << "\"erro\":" << jsonString(result.error) << "}\n";
+  }
+}
+
+/**
+ * @brief Simula todas as combinações de parâmetros em paralelo e escreve uma linha por configuração.
+ *
+ * O arquivo de instruções é decodificado uma vez para cada valor distinto de REGISTER_QNT (um
+ * .ttrace é usado direto do mapeamento) e compartilhado, somente para leitura, entre as simulações. Cada configuração é uma tarefa no
+ * conjunto de threads com roubo de trabalho e roda no modo dirigido a eventos, sem saída por
+ * ciclo. As linhas são escritas na ordem das combinações, independentemente da ordem de término.
+ *
+ * @return false se o arquivo de instruções não pôde ser aberto.
+ */
+inline bool runSweep(const std::string &tracePath, const SchedulerConfig &base, const std::vector<SweepRange> &ranges,
+                     unsigned threads, std::ostream &out, SweepFormat format, std::string &error)
+{
+  std::vector<SchedulerConfig> configs = expandSweep(base, ranges);
+  std::vector<SweepResult> results(configs.size());
+
+  // Decodifica o programa para cada quantidade de registradores usada
+  std::map<int, Program> programs;
+  std::map<int, std::string> programErrors;
+  for (size_t i = 0; i < configs.size(); i++)
+  {
+    results[i].config = configs[i];
+    if (!validateConfig(configs[i], results[i].error))
+    {
+      continue;
+    }
+    int registerQnt = configs[i].registerQnt;
+    if (programs.count(registerQnt) == 0 && programErrors.count(registerQnt) == 0)
+    {
+      std::string loadError;
+      TraceStatus status = programs[registerQnt].load(tracePath, registerQnt, loadError);
+      if (status == TraceStatus::Ok)
+      {
+        continue;
+      }
+      programs.erase(registerQnt);
+      if (status == TraceStatus::OpenFailed)
+      {
+        error = loadError;
+        return false;
+      }
+      programErrors[registerQnt] = loadError;
+    }
+    if (programErrors.count(registerQnt))
+    {
+      results[i].error = programErrors[registerQnt];
+    }
+  }
+
+  {
+    WorkStealingPool pool(threads);
+    for (size_t i = 0; i < configs.size(); i++)
+    {
+      if (!results[i].error.empty())
+      {
+        continue;
+      }
+      const Program &program = programs[configs[i].registerQnt];
+      SweepResult &result = results[i];
+      pool.submit([&program, &result]()
+                  {
+                    MemoryTrace trace(program.data(), program.size());
+                    std::ostream discard(nullptr);
+                    Scheduler scheduler(trace, discard, OutputFormat::None, true, result.config);
+                    scheduler.run();
+                    result.error = trace.error;
+                    result.cycles = scheduler.totalCycles();
+                    result.instructions = scheduler.completedCount;
+                    result.ipc = scheduler.ipc(); });
+    }
+    pool.wait();
+  }
+
+  writeSweepHeader(out, format);
+  for (const auto &result : results)
+  {
+    writeSweepRow(out, format, result);
+  }
+  return true;
+}
+
+#endif
@@ -0,0 +1,199 @@
+#ifndef TOMASULO_THREAD_POOL_HPP
+#define TOMASULO_THREAD_POOL_HPP
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+
+// Quantidade padrão de threads: um por núcleo do computador
+inline unsigned defaultThreadCount()
+{
+  unsigned threads = std::thread::hardware_concurrency();
+  return threads > 0 ? threads : 1;
+}
+
+/**
+ * @brief Conjunto de threads com roubo de trabalho.
+ *
+ * Cada thread tem sua própria fila de tarefas: consome as tarefas mais recentes da sua fila e,
+ * quando ela esvazia, rouba as mais antigas das filas das outras threads. As tarefas enviadas por
+ * submit() são distribuídas entre as filas em rodízio.
+ */
+class WorkStealingPool
+{
+public:
+  WorkStealingPool(unsigned threadCount = defaultThreadCount())
+      : queued(0), pending(0), nextQueue(0), stopping(false)
+  {
+    if (threadCount == 0)
+    {
+      threadCount = 1;
+    }
+    for (unsigned i = 0; i < threadCount; i++)
+    {
+      queues.push_back(std::unique_ptr<Queue>(new Queue()));
+    }
+    for (unsigned i = 0; i < threadCount; i++)
+    {
+      workers.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+  }
+
+  // Espera as tarefas pendentes e encerra as threads
+  ~WorkStealingPool()
+  {
+    wait();
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    wake.notify_all();
+    for (auto &worker : workers)
+    {
+      worker.join();
+    }
+  }
+
+  WorkStealingPool(const WorkStealingPool &) = delete;
+  WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+  size_t size() const
+  {
+    return workers.size();
+  }
+
+  // Enfileira uma tarefa; a tarefa não deve lançar exceções
+  void submit(std::function<void()> job)
+  {
+    Queue *queue;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      queue = queues[nextQueue].get();
+      nextQueue = (nextQueue + 1) % queues.size();
+      pending++;
+      queued++;
+    }
+    {
+      std::lock_guard<std::mutex> lock(queue->mutex);
+      queue->jobs.push_back(std::move(job));
+    }
+    wake.notify_one();
+  }
+
+  // Bloqueia até que todas as tarefas enviadas tenham terminado
+  void wait()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this]
+              { return pending == 0; });
+  }
+
+private:
+  struct Queue
+  {
+    std::mutex mutex;
+    std::deque<std::function<void()>> jobs;
+  };
+
+  std::vector<std::unique_ptr<Queue>> queues; // Uma fila por thread
+  std::vector<std::thread> workers;           // Threads do conjunto
+  std::mutex mutex;                           // Protege os contadores abaixo
+  std::condition_variable wake;               // Sinaliza novas tarefas ou encerramento
+  std::condition_variable idle;               // Sinaliza que não há tarefas pendentes
+  size_t queued;                              // Tarefas nas filas, ainda não iniciadas
+  size_t pending;                             // Tarefas enviadas e ainda não terminadas
+  size_t nextQueue;                           // Próxima fila a receber uma tarefa
+  bool stopping;                              // Indica que as threads devem terminar
+
+  // Retira uma tarefa da própria fila ou, se ela estiver vazia, rouba de outra thread
+  bool takeJob(size_t self, std::function<void()> &job)
+  {
+    for (size_t k = 0; k < queues.size(); k++)
+    {
+      Queue &queue = *queues[(self + k) % queues.size()];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      if (queue.jobs.empty())
+      {
+        continue;
+      }
+      if (k == 0)
+      {
+        job = std::move(queue.jobs.back());
+        queue.jobs.pop_back();
+      }
+      else
+      {
+        job = std::move(queue.jobs.front());
+        queue.jobs.pop_front();
+      }
+      return true;
+    }
+    return false;
+  }
+
+  void workerLoop(size_t self)
+  {
+    for (;;)
+    {
+      std::function<void()> job;
+      if (takeJob(self, job))
+      {
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          queued--;
+        }
+        job();
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--pending == 0)
+        {
+          idle.notify_all();
+        }
+        continue;
+      }
+
+      std::unique_lock<std::mutex> lock(mutex);
+      wake.wait(lock, [this]
+                { return stopping || queued > 0; });
+      if (stopping && queued == 0)
+      {
+        return;
+      }
+    }
+  }
+};
+
+// Barreira reutilizável: cada chamada de wait() bloqueia até que `count` threads a alcancem
+class Barrier
+{
+public:
+  explicit Barrier(size_t count)
+      : count(count), waiting(0), generation(0) {}
+
+  void wait()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    size_t current = generation;
+    if (++waiting == count)
+    {
+      waiting = 0;
+      generation++;
+      released.notify_all();
+      return;
+    }
+    released.wait(lock, [this, current]
+                  { return generation != current; });
+  }
+
+private:
+  std::mutex mutex;
+  std::condition_variable released;
+  size_t count;      // Threads que participam
+  size_t waiting;    // Threads que já chegaram nesta rodada
+  size_t generation; // Rodadas completadas
+};
+
+#endif
@@ -0,0 +1,312 @@
+#ifndef TOMASULO_TRACEFILE_HPP
+#define TOMASULO_TRACEFILE_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "instruction.hpp"
+#include "mapped_file.hpp"
+
+/**
+ * Formato .ttrace: instruções já decodificadas, lidas direto do mapeamento do arquivo.
+ *
+ *   cabeçalho  TTraceHeader (24 bytes)
+ *   registros  `count` instruções de 8 bytes (struct Instruction), em ordem de programa
+ *
+ * Os índices de registrador dependem de REGISTER_QNT, que é gravado no cabeçalho e conferido ao
+ * abrir. Os inteiros estão na ordem de bytes de quem gravou; TTRACE_BYTE_ORDER identifica a ordem.
+ */
+const char TTRACE_MAGIC[4] = {'T', 'T', 'R', 'C'};
+const std::uint32_t TTRACE_VERSION = 1;
+const std::uint32_t TTRACE_BYTE_ORDER = 0x01020304;
+
+struct TTraceHeader
+{
+  char magic[4];
+  std::uint32_t version;
+  std::uint32_t byteOrder;
+  std::int32_t registerQnt;
+  std::uint64_t count;
+};
+
+static_assert(sizeof(TTraceHeader) == 24 && sizeof(Instruction) == 8, "layout do .ttrace mudou");
+static_assert(std::is_trivially_copyable<Instruction>::value, "instruções do .ttrace são copiadas byte a byte");
+
+// Indica se o conteúdo começa com o identificador do formato .ttrace
+inline bool isTTrace(const char *data, size_t size)
+{
+  return size >= sizeof(TTRACE_MAGIC) && std::memcmp(data, TTRACE_MAGIC, sizeof(TTRACE_MAGIC)) == 0;
+}
+
+/**
+ * @brief Arquivo de instruções em texto mapeado em memória.
+ *
+ * As linhas são decodificadas no lugar, sem cópia nem alocação; linhas em branco são ignoradas e
+ * a primeira linha inválida encerra a leitura com o erro e o número da linha.
+ */
+class MappedTrace : public TraceSource
+{
+public:
+  MappedFile file;  // Conteúdo do arquivo
+  int registerQnt;  // Quantidade de registradores F (e R) usada na decodificação
+  size_t position;  // Início da próxima linha
+  int lineNumber;   // Última linha lida
+
+  MappedTrace(MappedFile &&file, int registerQnt = REGISTER_QNT)
+      : file(std::move(file)), registerQnt(registerQnt), position(0), lineNumber(0) {}
+
+  bool next(Instruction &inst) override
+  {
+    while (error.empty() && position < file.size)
+    {
+      const char *start = file.data + position;
+      const char *end = static_cast<const char *>(std::memchr(start, '\n', file.size - position));
+      size_t length = end ? static_cast<size_t>(end - start) : file.size - position;
+      position += length + 1;
+      lineNumber++;
+
+      std::string_view line(start, length);
+      if (line.find_first_not_of(" \t\r") == std::string_view::npos)
+      {
+        continue;
+      }
+
+      std::string reason;
+      if (!decodeInstruction(line, inst, reason, registerQnt))
+      {
+        error = "linha " + std::to_string(lineNumber) + ": " + reason;
+        return false;
+      }
+      return true;
+    }
+    return false;
+  }
+};
+
+// Indica se um registro do .ttrace é uma instrução que decodeInstruction poderia ter produzido
+inline bool isValidRecord(const Instruction &inst, int registerQnt)
+{
+  int archRegisterQnt = 2 * registerQnt;
+  if (inst.op > OpCode::Sw || inst.dest >= archRegisterQnt || inst.src2 >= archRegisterQnt)
+  {
+    return false;
+  }
+  return isMemoryOp(inst.op) ? inst.src1 == NO_REGISTER : inst.src1 < archRegisterQnt;
+}
+
+// Arquivo .ttrace mapeado em memória: as instruções são entregues sem decodificação
+class TTraceFile : public MemoryTrace
+{
+public:
+  MappedFile file; // Conteúdo do arquivo
+
+  TTraceFile()
+      : MemoryTrace(nullptr, 0) {}
+
+  // Confere o cabeçalho e cada registro uma vez; `registerQnt` deve ser o usado ao gravar o arquivo
+  bool open(MappedFile &&mapped, int registerQnt, std::string &error)
+  {
+    file = std::move(mapped);
+    TTraceHeader header;
+    if (file.size < sizeof(header))
+    {
+      error = "arquivo .ttrace inválido";
+      return false;
+    }
+    std::memcpy(&header, file.data, sizeof(header));
+    if (!isTTrace(file.data, file.size) || header.version != TTRACE_VERSION ||
+        header.byteOrder != TTRACE_BYTE_ORDER)
+    {
+      error = "versão ou ordem de bytes do .ttrace não suportada";
+      return false;
+    }
+    if (header.count != (file.size - sizeof(header)) / sizeof(Instruction) ||
+        (file.size - sizeof(header)) % sizeof(Instruction) != 0)
+    {
+      error = "arquivo .ttrace truncado";
+      return false;
+    }
+    if (header.registerQnt != registerQnt)
+    {
+      error = "arquivo .ttrace gravado com REGISTER_QNT=" + std::to_string(header.registerQnt);
+      return false;
+    }
+    instructions = reinterpret_cast<const Instruction *>(file.data + sizeof(header));
+    for (std::uint64_t i = 0; i < header.count; i++)
+    {
+      if (!isValidRecord(instructions[i], registerQnt))
+      {
+        error = "arquivo .ttrace inválido: instrução " + std::to_string(i + 1) + " com operação ou registrador inválido";
+        instructions = nullptr;
+        return false;
+      }
+    }
+    count = header.count;
+    position = 0;
+    return true;
+  }
+};
+
+// Arquivo de instruções em texto que não pode ser mapeado (pipe, dispositivo), lido linha a linha
+class StreamTrace : public TraceSource
+{
+public:
+  std::ifstream input;
+  TraceReader reader;
+
+  StreamTrace(const std::string &path, int registerQnt)
+      : input(path), reader(input, registerQnt) {}
+
+  bool next(Instruction &inst) override
+  {
+    bool read = reader.next(inst);
+    error = reader.error;
+    return read;
+  }
+};
+
+// Resultado da abertura ou leitura de um arquivo de instruções
+enum class TraceStatus : std::uint8_t
+{
+  Ok,
+  OpenFailed, // O arquivo não pôde ser aberto
+  Invalid     // O arquivo abriu, mas tem um .ttrace ou uma linha inválida
+};
+
+/**
+ * @brief Abre um arquivo de instruções em texto ou .ttrace, identificado pelo conteúdo.
+ *
+ * Arquivos regulares são mapeados em memória; os demais são lidos como texto.
+ *
+ * @param status Motivo da falha, quando o arquivo não é aberto (saída).
+ * @return nullptr se o arquivo não pôde ser aberto ou é um .ttrace inválido (error é preenchido).
+ */
+inline std::unique_ptr<TraceSource> openTrace(const std::string &path, int registerQnt, std::string &error,
+                                              TraceStatus &status)
+{
+  status = TraceStatus::Ok;
+  MappedFile file;
+  std::string mapError;
+  if (!file.open(path, mapError))
+  {
+    auto stream = std::make_unique<StreamTrace>(path, registerQnt);
+    if (!stream->input.is_open())
+    {
+      error = "erro ao abrir o arquivo de instruções";
+      status = TraceStatus::OpenFailed;
+      return nullptr;
+    }
+    return stream;
+  }
+  if (isTTrace(file.data, file.size))
+  {
+    auto trace = std::make_unique<TTraceFile>();
+    if (!trace->open(std::move(file), registerQnt, error))
+    {
+      status = TraceStatus::Invalid;
+      return nullptr;
+    }
+    return trace;
+  }
+  return std::make_unique<MappedTrace>(std::move(file), registerQnt);
+}
+
+inline std::unique_ptr<TraceSource> openTrace(const std::string &path, int registerQnt, std::string &error)
+{
+  TraceStatus status;
+  return openTrace(path, registerQnt, error, status);
+}
+
+/**
+ * @brief Grava as instruções de uma fonte no formato .ttrace.
+ *
+ * @return false se a fonte tiver uma linha inválida ou o arquivo não puder ser gravado.
+ */
+inline bool writeTTrace(TraceSource &trace, int registerQnt, const std::string &path, std::string &error)
+{
+  std::ofstream out(path, std::ios::binary);
+  if (!out.is_open())
+  {
+    error = "erro ao criar '" + path + "'";
+    return false;
+  }
+  TTraceHeader header{{}, TTRACE_VERSION, TTRACE_BYTE_ORDER, registerQnt, 0};
+  std::memcpy(header.magic, TTRACE_MAGIC, sizeof(header.magic));
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+  Instruction inst;
+  while (trace.next(inst))
+  {
+    out.write(reinterpret_cast<const char *>(&inst), sizeof(inst));
+    header.count++;
+  }
+  if (!trace.error.empty())
+  {
+    error = trace.error;
+    return false;
+  }
+  out.seekp(0);
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  if (!out)
+  {
+    error = "erro ao gravar '" + path + "'";
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Programa inteiro em memória, para ser compartilhado entre várias simulações.
+ *
+ * Um .ttrace é usado direto do mapeamento, sem cópia; um arquivo em texto é decodificado uma vez.
+ */
+class Program
+{
+public:
+  const Instruction *data() const
+  {
+    return mapped.count ? mapped.instructions : decoded.data();
+  }
+
+  size_t size() const
+  {
+    return mapped.count ? mapped.count : decoded.size();
+  }
+
+  // Retorna TraceStatus::Ok se todas as instruções foram lidas
+  TraceStatus load(const std::string &path, int registerQnt, std::string &error)
+  {
+    TraceStatus status;
+    std::unique_ptr<TraceSource> trace = openTrace(path, registerQnt, error, status);
+    if (!trace)
+    {
+      return status;
+    }
+    if (auto *binary = dynamic_cast<TTraceFile *>(trace.get()))
+    {
+      mapped.file = std::move(binary->file);
+      mapped.instructions = binary->instructions;
+      mapped.count = binary->count;
+      return TraceStatus::Ok;
+    }
+    Instruction inst;
+    while (trace->next(inst))
+    {
+      decoded.push_back(inst);
+    }
+    error = trace->error;
+    return error.empty() ? TraceStatus::Ok : TraceStatus::Invalid;
+  }
+
+private:
+  TTraceFile mapped;
+  std::vector<Instruction> decoded;
+};
+
+#endif
@@ -0,0 +1,142 @@
+#ifndef TOMASULO_TRACEGEN_HPP
+#define TOMASULO_TRACEGEN_HPP
+
+#include <cstdint>
+#include <string>
+
+#include "config.hpp"
+#include "instruction.hpp"
+
+// Padrões de programas sintéticos
+enum class TracePattern : std::uint8_t
+{
+  Chain,  // Cada instrução depende da anterior (cadeia longa de RAW)
+  Ilp,    // Fluxos independentes: só lê registradores que nunca são escritos
+  Memory, // Predominância de lw/sw com poucos cálculos
+  Waw,    // Poucos destinos reescritos o tempo todo (muitas renomeações)
+  Mixed   // Instruções e registradores aleatórios
+};
+
+const int TRACE_PATTERN_QNT = 5;
+
+const char *const TRACE_PATTERN_NAMES[TRACE_PATTERN_QNT] = {"cadeia", "ilp", "memoria", "waw", "misto"};
+
+// Procura um padrão pelo nome; retorna false se não existir
+inline bool findTracePattern(const std::string &name, TracePattern &pattern)
+{
+  for (int i = 0; i < TRACE_PATTERN_QNT; i++)
+  {
+    if (name == TRACE_PATTERN_NAMES[i])
+    {
+      pattern = static_cast<TracePattern>(i);
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Gera um programa sintético sob demanda, sem guardá-lo em memória.
+ *
+ * A sequência depende apenas do padrão, da quantidade de instruções e da semente, então pode ser
+ * reproduzida em qualquer máquina. Usa apenas os registradores F0..F15 e R0..R15 para que o
+ * programa seja válido com a configuração padrão.
+ */
+class SyntheticTrace : public TraceSource
+{
+public:
+  SyntheticTrace(TracePattern pattern, std::uint64_t count, std::uint64_t seed = 1)
+      : pattern(pattern), remaining(count), state(seed ? seed : 1), position(0) {}
+
+  bool next(Instruction &inst) override
+  {
+    if (remaining == 0)
+    {
+      return false;
+    }
+    remaining--;
+    inst = generate();
+    position++;
+    return true;
+  }
+
+private:
+  static const int REGS = 16; // Registradores F (e R) usados
+
+  TracePattern pattern;
+  std::uint64_t remaining; // Instruções ainda não geradas
+  std::uint64_t state;     // Estado do gerador xorshift64*
+  std::uint64_t position;  // Posição da instrução no programa
+
+  std::uint64_t random()
+  {
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 0x2545F4914F6CDD1DULL;
+  }
+
+  std::uint8_t pick(std::uint64_t n)
+  {
+    return static_cast<std::uint8_t>(random() % n);
+  }
+
+  static std::uint8_t f(int i)
+  {
+    return static_cast<std::uint8_t>(i);
+  }
+
+  static std::uint8_t r(int i)
+  {
+    return static_cast<std::uint8_t>(REGS + i);
+  }
+
+  OpCode arithmetic()
+  {
+    return static_cast<OpCode>(pick(4)); // Add, Sub, Mul ou Div
+  }
+
+  Instruction generate()
+  {
+    int k = static_cast<int>(position % REGS);
+    switch (pattern)
+    {
+    case TracePattern::Chain:
+      // Fk+1 = Fk op R: o destino de uma instrução é a fonte da seguinte
+      return Instruction{arithmetic(), f((k + 1) % REGS), f(k), r(pick(REGS)), 0};
+    case TracePattern::Ilp:
+      // Destinos em rodízio e fontes somente em R, que nunca é escrito
+      return Instruction{arithmetic(), f(k), r(pick(REGS)), r(pick(REGS)), 0};
+    case TracePattern::Memory:
+    {
+      std::uint64_t choice = random() % 8;
+      std::int32_t imm = static_cast<std::int32_t>(random() % 100);
+      if (choice < 4)
+      {
+        return Instruction{OpCode::Lw, f(pick(REGS)), NO_REGISTER, r(pick(REGS)), imm};
+      }
+      if (choice < 7)
+      {
+        return Instruction{OpCode::Sw, f(pick(REGS)), NO_REGISTER, r(pick(REGS)), imm};
+      }
+      return Instruction{OpCode::Add, f(pick(REGS)), f(pick(REGS)), f(pick(REGS)), 0};
+    }
+    case TracePattern::Waw:
+      // Dois destinos reescritos por instruções que leem registradores independentes
+      return Instruction{arithmetic(), f(k % 2), r(pick(REGS)), f(2 + pick(REGS - 2)), 0};
+    default:
+    {
+      OpCode op = static_cast<OpCode>(pick(6));
+      std::uint8_t dest = pick(2 * REGS);
+      std::uint8_t src2 = pick(2 * REGS);
+      if (isMemoryOp(op))
+      {
+        return Instruction{op, dest, NO_REGISTER, src2, static_cast<std::int32_t>(random() % 100)};
+      }
+      return Instruction{op, dest, pick(2 * REGS), src2, 0};
+    }
+    }
+  }
+};
+
+#endif
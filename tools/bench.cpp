@@ -0,0 +1,216 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <new>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include "../src/functional.hpp"
+#include "../src/scheduler.hpp"
+#include "../src/tracegen.hpp"
+
+// Alocações dinâmicas feitas pelo processo, para verificar que a simulação não aloca por ciclo
+static std::atomic<std::uint64_t> allocationCount{0};
+
+// As formas simples, de vetor e com tamanho de new e delete são substituídas juntas e todas passam
+// pelo mesmo par malloc/free. O delete não é expandido no chamador para que o compilador veja
+// new e delete casados, e não um free de um bloco devolvido por operator new.
+void *operator new(std::size_t size)
+{
+  allocationCount.fetch_add(1, std::memory_order_relaxed);
+  if (void *ptr = std::malloc(size ? size : 1))
+  {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+  return ::operator new(size);
+}
+
+[[gnu::noinline]] void operator delete(void *ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+  ::operator delete(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+  ::operator delete(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept
+{
+  ::operator delete(ptr);
+}
+
+// Pico de memória residente do processo, em KiB
+long peakRssKb()
+{
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+// Resultado de uma execução medida
+struct Measurement
+{
+  int cycles = 0;
+  double seconds = 0.0;
+  std::uint64_t allocations = 0;
+};
+
+// Mede o tempo e as alocações de run() de um simulador, sem contar a construção
+template <typename Simulated>
+Measurement measure(Simulated &simulated, TraceSource &trace, std::uint64_t count)
+{
+  Measurement result;
+  result.allocations = allocationCount;
+  auto start = std::chrono::steady_clock::now();
+  if constexpr (std::is_same<Simulated, FunctionalSimulator>::value)
+  {
+    simulated.run(trace, count);
+  }
+  else
+  {
+    simulated.run();
+    result.cycles = simulated.totalCycles();
+  }
+  result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  result.allocations = allocationCount - result.allocations;
+  return result;
+}
+
+/**
+ * Mede a vazão de Scheduler::run() com programas sintéticos de 10^3 até --max instruções.
+ * Com --funcional mede a execução funcional (FunctionalSimulator), sem modelo de tempo; nesse caso
+ * a coluna de ciclos fica zerada. Com --especializado mede o ProductionScheduler, especializado em
+ * tempo de compilação para a configuração padrão, no lugar do Scheduler configurado em execução.
+ *
+ * As instruções são geradas sob demanda e o estado por ciclo não é gravado, então o tempo medido é
+ * o do simulador. O pico de RSS é o do processo até o fim de cada execução; como a janela é
+ * limitada, ele não deve crescer com a quantidade de instruções. A coluna de alocações conta as
+ * alocações dinâmicas feitas durante run(), que também não devem crescer com o programa.
+ */
+int main(int argc, char *argv[])
+{
+  std::uint64_t maxCount = 1000000;
+  bool eventDriven = false;
+  bool csv = false;
+  bool functional = false;
+  bool specialized = false;
+  std::vector<TracePattern> patterns;
+  for (int i = 1; i < argc; i++)
+  {
+    std::string arg = argv[i];
+    TracePattern pattern;
+    if (arg == "--eventos")
+    {
+      eventDriven = true;
+    }
+    else if (arg == "--funcional")
+    {
+      functional = true;
+    }
+    else if (arg == "--especializado")
+    {
+      specialized = true;
+    }
+    else if (arg == "--csv")
+    {
+      csv = true;
+    }
+    else if (arg.rfind("--max=", 0) == 0)
+    {
+      try
+      {
+        maxCount = std::stoull(arg.substr(6));
+      }
+      catch (const std::exception &)
+      {
+        maxCount = 0;
+      }
+    }
+    else if (arg.rfind("--padrao=", 0) == 0 && findTracePattern(arg.substr(9), pattern))
+    {
+      patterns.push_back(pattern);
+    }
+    else
+    {
+      std::cerr << "Uso: " << argv[0] << " [--max=N] [--padrao=cadeia|ilp|memoria|waw|misto]... [--eventos] [--funcional | --especializado] [--csv]" << std::endl;
+      return 1;
+    }
+  }
+  if (patterns.empty())
+  {
+    for (int i = 0; i < TRACE_PATTERN_QNT; i++)
+    {
+      patterns.push_back(static_cast<TracePattern>(i));
+    }
+  }
+
+  if (csv)
+  {
+    std::cout << "padrao,instrucoes,ciclos,segundos,instrucoes_por_segundo,rss_pico_kb,alocacoes\n";
+  }
+  else
+  {
+    std::cout << "Padrão      Instruções      Ciclos   Tempo (s)         Instr/s  RSS pico (KiB)   Alocações\n";
+  }
+
+  for (TracePattern pattern : patterns)
+  {
+    for (std::uint64_t count = 1000; count <= maxCount; count *= 10)
+    {
+      SyntheticTrace trace(pattern, count);
+      std::ostream discard(nullptr);
+      Measurement result;
+      if (functional)
+      {
+        FunctionalSimulator functionalSimulator;
+        result = measure(functionalSimulator, trace, count);
+      }
+      else if (specialized)
+      {
+        ProductionScheduler scheduler(trace, discard, OutputFormat::None, eventDriven);
+        result = measure(scheduler, trace, count);
+      }
+      else
+      {
+        Scheduler scheduler(trace, discard, OutputFormat::None, eventDriven);
+        result = measure(scheduler, trace, count);
+      }
+      double seconds = result.seconds;
+      std::uint64_t allocations = result.allocations;
+      double rate = seconds > 0 ? count / seconds : 0.0;
+      const char *name = TRACE_PATTERN_NAMES[static_cast<int>(pattern)];
+
+      if (csv)
+      {
+        std::cout << name << "," << count << "," << result.cycles << "," << seconds << ","
+                  << static_cast<std::uint64_t>(rate) << "," << peakRssKb() << "," << allocations << "\n";
+      }
+      else
+      {
+        std::cout << std::left << std::setw(10) << name << std::right << std::setw(12) << count
+                  << std::setw(12) << result.cycles << std::setw(12) << std::fixed
+                  << std::setprecision(4) << seconds << std::setw(16) << static_cast<std::uint64_t>(rate)
+                  << std::setw(16) << peakRssKb() << std::setw(12) << allocations << "\n";
+      }
+      std::cout.flush();
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,60 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+
+#include "../src/lz4.hpp"
+#include "../src/report.hpp"
+
+// Converte um arquivo de saída no formato delta, comprimido ou não, para o relatório legível
+int main(int argc, char *argv[])
+{
+  if (argc < 3)
+  {
+    std::cerr << "Uso: " << argv[0] << " <arquivo_delta> <arquivo_de_saida>" << std::endl;
+    return 1;
+  }
+
+  std::ifstream input(argv[1], std::ios::binary);
+  if (!input.is_open())
+  {
+    std::cerr << "Erro ao abrir o arquivo delta." << std::endl;
+    return 1;
+  }
+
+  std::ofstream outputFile(argv[2]);
+  if (!outputFile.is_open())
+  {
+    std::cerr << "Erro ao abrir o arquivo de saída." << std::endl;
+    return 1;
+  }
+
+  // Saída gravada com --comprimir: o quadro LZ4 é descomprimido durante a leitura
+  char magic[4] = {};
+  input.read(magic, sizeof(magic));
+  bool compressed = input.gcount() == sizeof(magic) && lz4Read32(magic) == LZ4_FRAME_MAGIC;
+  input.clear();
+  std::string error;
+  if (compressed)
+  {
+    Lz4InputBuffer frame(input);
+    std::istream decompressed(&frame);
+    if (!decodeDelta(decompressed, outputFile, error) || !frame.error.empty())
+    {
+      error = frame.error.empty() ? error : frame.error;
+    }
+  }
+  else
+  {
+    input.seekg(0);
+    decodeDelta(input, outputFile, error);
+  }
+  if (!error.empty())
+  {
+    std::cerr << "Erro ao decodificar: " << error << std::endl;
+    return 1;
+  }
+
+  outputFile.close();
+
+  return 0;
+}
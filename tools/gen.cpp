@@ -0,0 +1,55 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+
+#include "../src/tracegen.hpp"
+
+// Gera um arquivo de instruções sintético para testes de desempenho
+int main(int argc, char *argv[])
+{
+  TracePattern pattern;
+  if (argc < 4 || !findTracePattern(argv[1], pattern))
+  {
+    std::cerr << "Uso: " << argv[0] << " <cadeia|ilp|memoria|waw|misto> <quantidade> <arquivo_de_saida> [semente]" << std::endl;
+    return 1;
+  }
+
+  std::uint64_t count, seed = 1;
+  try
+  {
+    count = std::stoull(argv[2]);
+    if (argc > 4)
+    {
+      seed = std::stoull(argv[4]);
+    }
+  }
+  catch (const std::exception &)
+  {
+    std::cerr << "Quantidade ou semente inválida." << std::endl;
+    return 1;
+  }
+
+  std::ofstream outputFile(argv[3]);
+  if (!outputFile.is_open())
+  {
+    std::cerr << "Erro ao abrir o arquivo de saída." << std::endl;
+    return 1;
+  }
+
+  SyntheticTrace trace(pattern, count, seed);
+  Instruction inst;
+  bool first = true;
+  while (trace.next(inst))
+  {
+    if (!first)
+    {
+      outputFile << "\n";
+    }
+    writeInstruction(outputFile, inst);
+    first = false;
+  }
+
+  outputFile.close();
+
+  return 0;
+}
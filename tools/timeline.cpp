@@ -0,0 +1,86 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "../src/scheduler.hpp"
+
+// Ciclos de cada estágio de uma instrução
+struct TimelineRow
+{
+  Instruction inst;
+  int issue = 0;
+  int dispatch = 0;
+  int complete = 0;
+  int writeback = 0;
+};
+
+// Observador que guarda o ciclo de cada evento das instruções, indexado pelo número de sequência
+struct TimelineObserver
+{
+  std::vector<TimelineRow> *rows;
+
+  void issue(int cycle, const Operation &op)
+  {
+    rows->push_back(TimelineRow{op.inst, cycle});
+  }
+
+  void dispatch(int cycle, const Operation &op, UnitType, size_t)
+  {
+    (*rows)[op.seq].dispatch = cycle;
+  }
+
+  void complete(int cycle, const Operation &op)
+  {
+    (*rows)[op.seq].complete = cycle;
+  }
+
+  void writeback(int cycle, const Operation &op)
+  {
+    (*rows)[op.seq].writeback = cycle;
+  }
+
+  void registerWrite(int, std::uint8_t, int) {}
+};
+
+/**
+ * Exemplo de uso do simulador como biblioteca: simula um arquivo de instruções com um observador e
+ * escreve, para cada instrução, os ciclos de emissão, despacho, fim da execução e escrita.
+ */
+int main(int argc, char *argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Uso: " << argv[0] << " <arquivo_de_instrucoes>" << std::endl;
+    return 1;
+  }
+
+  std::ifstream input(argv[1]);
+  if (!input.is_open())
+  {
+    std::cerr << "Erro ao abrir o arquivo de instruções." << std::endl;
+    return 1;
+  }
+
+  std::vector<TimelineRow> rows;
+  TraceReader trace(input);
+  std::ostream discard(nullptr);
+  BasicScheduler<TimelineObserver> scheduler(trace, discard, OutputFormat::None, false, SchedulerConfig(),
+                                             TimelineObserver{&rows});
+  while (scheduler.step())
+  {
+  }
+  if (!trace.error.empty())
+  {
+    std::cerr << "Erro na " << trace.error << std::endl;
+    return 1;
+  }
+
+  std::cout << "instrução\temissão\tdespacho\tfim\tescrita\n";
+  for (const auto &row : rows)
+  {
+    writeInstruction(std::cout, row.inst);
+    std::cout << "\t" << row.issue << "\t" << row.dispatch << "\t" << row.complete << "\t" << row.writeback << "\n";
+  }
+  return 0;
+}